@@ -0,0 +1,76 @@
+/**
+ * @brief Benchmark di raccolta eventi da più thread: `zkl::concurrent_vector` contro un `zkl::vector` protetto da mutex.
+ *
+ * Per 1, 2, 4, 8 e 16 thread ognuno aggiunge lo stesso numero di eventi allo stesso contenitore;
+ * si stampa il tempo medio per inserimento, misurato sul tempo totale dall'avvio all'ultimo `join`.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/concurrent_vector.cpp -o bench/concurrent_vector.exe -lpthread
+ *
+ * Uso:
+ *   bench/concurrent_vector.exe [eventi per thread]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atol
+#include <iostream> // Per funzioni io
+#include <mutex>    // Per std::mutex
+#include <thread>   // Per std::thread
+
+/**
+ * @brief Un evento come quelli raccolti dai collettori.
+ */
+struct event
+{
+  long timestamp;
+  int source;
+  int kind;
+};
+
+/**
+ * @brief Avvia `threads` thread che eseguono `body(thread, events)` e restituisce i nanosecondi per evento.
+ */
+template <typename Body>
+double nsPerEvent(int threads, long events, Body body)
+{
+  zkl::vector<std::thread> workers;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < threads; t++)
+    workers.emplace_back(body, t, events);
+  for (std::thread& worker : workers)
+    worker.join();
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / (events * threads);
+}
+
+int main(int argc, char** argv)
+{
+  long events = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+  std::cout << "eventi per thread: " << events << " (ns/evento)\n";
+  std::cout << "thread\tmutex + zkl::vector\tzkl::concurrent_vector\n";
+
+  for (int threads = 1; threads <= 16; threads *= 2)
+  {
+    zkl::vector<event> locked;
+    std::mutex mutex;
+    double lockedNs = nsPerEvent(threads, events, [&](int source, long count)
+                                 {
+                                   for (long i = 0; i < count; i++)
+                                   {
+                                     std::lock_guard<std::mutex> lock(mutex);
+                                     locked.push_back(event{i, source, 0});
+                                   } });
+
+    zkl::concurrent_vector<event> concurrent;
+    double concurrentNs = nsPerEvent(threads, events, [&](int source, long count)
+                                     {
+                                       for (long i = 0; i < count; i++)
+                                         concurrent.push_back(event{i, source, 0}); });
+
+    std::cout << threads << "\t" << lockedNs << "\t\t\t" << concurrentNs << "\n";
+  }
+
+  return 0;
+}
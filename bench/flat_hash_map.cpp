@@ -0,0 +1,149 @@
+/**
+ * @brief Benchmark di `zkl::flat_hash_map` contro `std::unordered_map`.
+ *
+ * Per chiavi intere e chiavi stringa misura il tempo medio di:
+ * - inserimento di N chiavi distinte in una tabella vuota;
+ * - ricerca di chiavi presenti (in ordine casuale, così la cache non aiuta);
+ * - ricerca di chiavi assenti;
+ * - cancellazione di tutte le chiavi.
+ * Le chiavi stringa sono `zkl::string` per `zkl::flat_hash_map` e `std::string` per `std::unordered_map`;
+ * per `zkl::flat_hash_map` si misura anche la ricerca eterogenea con `const char*`.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/flat_hash_map.cpp -o bench/flat_hash_map.exe
+ *
+ * Uso:
+ *   bench/flat_hash_map.exe [numero di chiavi]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>        // Per std::chrono
+#include <cstdio>        // Per std::snprintf
+#include <cstdlib>       // Per std::atol
+#include <iostream>      // Per funzioni io
+#include <random>        // Per std::mt19937_64
+#include <string>        // Per std::string
+#include <unordered_map> // Per std::unordered_map
+#include <vector>        // Per std::vector
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Esegue `body` e restituisce i nanosecondi medi per operazione.
+ */
+template <typename Body>
+double nsPerOp(size_t operations, Body body)
+{
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+}
+
+/**
+ * @brief Misura inserimento, ricerca e cancellazione per un tipo di tabella.
+ *
+ * @param name Nome stampato nella riga dei risultati.
+ * @param keys Le chiavi da inserire.
+ * @param order Ordine casuale in cui cercare le chiavi presenti.
+ * @param missing Chiavi non presenti nella tabella.
+ */
+template <typename Map, typename Key>
+void measure(const char* name, const std::vector<Key>& keys, const std::vector<size_t>& order, const std::vector<Key>& missing)
+{
+  Map map;
+  size_t n = keys.size();
+
+  double insertNs = nsPerOp(n, [&]()
+                            {
+                              for (size_t i = 0; i < n; i++)
+                                map[keys[i]] = i; });
+
+  size_t found = 0;
+  double hitNs = nsPerOp(n, [&]()
+                         {
+                           for (size_t i = 0; i < n; i++)
+                             found += map.find(keys[order[i]]) != map.end(); });
+
+  double missNs = nsPerOp(n, [&]()
+                          {
+                            for (size_t i = 0; i < n; i++)
+                              found += map.find(missing[i]) != map.end(); });
+
+  double eraseNs = nsPerOp(n, [&]()
+                           {
+                             for (size_t i = 0; i < n; i++)
+                               found += map.erase(keys[order[i]]); });
+
+  doNotOptimize(found);
+  std::cout << name << "\t" << insertNs << "\t" << hitNs << "\t" << missNs << "\t" << eraseNs << "\n";
+}
+
+/**
+ * @brief Misura la ricerca eterogenea con `const char*` in una `zkl::flat_hash_map` con chiavi `zkl::string`.
+ */
+void measureHeterogeneous(const std::vector<std::string>& keys, const std::vector<size_t>& order)
+{
+  zkl::flat_hash_map<zkl::string, size_t> map;
+  size_t n = keys.size();
+  for (size_t i = 0; i < n; i++)
+    map[zkl::string(keys[i].c_str())] = i;
+
+  size_t found = 0;
+  double hitNs = nsPerOp(n, [&]()
+                         {
+                           for (size_t i = 0; i < n; i++)
+                             found += map.find(keys[order[i]].c_str()) != map.end(); });
+
+  doNotOptimize(found);
+  std::cout << "zkl::flat_hash_map (const char* lookup)\t-\t" << hitNs << "\t-\t-\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+  std::mt19937_64 rng(42);
+
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i < n; i++)
+    order[i] = i;
+  for (size_t i = n; i > 1; i--)
+    std::swap(order[i - 1], order[rng() % i]);
+
+  std::vector<long> intKeys(n), intMissing(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    intKeys[i] = static_cast<long>(rng() >> 1);
+    intMissing[i] = -static_cast<long>(i) - 1;
+  }
+
+  std::vector<std::string> stdKeys(n), stdMissing(n);
+  std::vector<zkl::string> zklKeys(n), zklMissing(n);
+  char buffer[64];
+  for (size_t i = 0; i < n; i++)
+  {
+    std::snprintf(buffer, sizeof(buffer), "user:%016llx:profile", static_cast<unsigned long long>(rng()));
+    stdKeys[i] = buffer;
+    zklKeys[i] = buffer;
+    std::snprintf(buffer, sizeof(buffer), "missing:%zu", i);
+    stdMissing[i] = buffer;
+    zklMissing[i] = buffer;
+  }
+
+  std::cout << "chiavi: " << n << " (ns/op)\n";
+  std::cout << "tabella\tinsert\tfind hit\tfind miss\terase\n";
+
+  measure<zkl::flat_hash_map<long, size_t>>("zkl::flat_hash_map<long>", intKeys, order, intMissing);
+  measure<std::unordered_map<long, size_t>>("std::unordered_map<long>", intKeys, order, intMissing);
+  measure<zkl::flat_hash_map<zkl::string, size_t>>("zkl::flat_hash_map<zkl::string>", zklKeys, order, zklMissing);
+  measure<std::unordered_map<std::string, size_t>>("std::unordered_map<std::string>", stdKeys, order, stdMissing);
+  measureHeterogeneous(stdKeys, order);
+
+  return 0;
+}
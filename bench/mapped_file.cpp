@@ -0,0 +1,138 @@
+/**
+ * @brief Benchmark di lettura per righe: `zkl::mapped_file::lines()` contro `zkl::getline` e `std::getline`.
+ *
+ * Scrive un file di righe di lunghezza variabile (oppure usa un file esistente), poi lo legge per
+ * intero nei tre modi contando righe e byte, e stampa il throughput in MB/s. Il file viene letto
+ * una prima volta per scaldare la page cache, così si misura l'elaborazione e non il disco.
+ * `zkl::getline` salta gli spazi iniziali, quindi anche le righe vuote: il suo conteggio è più
+ * basso e si confrontano solo `mapped_file` e `std::getline`.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/mapped_file.cpp -o bench/mapped_file.exe
+ *
+ * Uso:
+ *   bench/mapped_file.exe [MB da generare] [percorso del file]
+ *
+ * Se il percorso esiste già e non si indicano MB (0), il file viene letto così com'è.
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdio>   // Per std::remove
+#include <cstdlib>  // Per std::atol
+#include <fstream>  // Per std::ifstream, std::ofstream
+#include <iostream> // Per funzioni io
+#include <random>   // Per std::mt19937
+#include <string>   // Per std::string
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Righe e byte letti da un metodo.
+ */
+struct tally
+{
+  size_t lines; /**< Numero di righe. */
+  size_t bytes; /**< Byte delle righe, delimitatori esclusi. */
+};
+
+/**
+ * @brief Esegue `body` e restituisce i millisecondi trascorsi.
+ */
+template <typename Body>
+double milliseconds(Body body)
+{
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Stampa una riga della tabella.
+ */
+void report(const char* method, size_t fileSize, double ms, const tally& t)
+{
+  std::cout << method << "\t" << ms << "\t\t" << fileSize / 1e3 / ms << "\t\t" << t.lines << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  long megabytes = argc > 1 ? std::atol(argv[1]) : 256;
+  const char* path = argc > 2 ? argv[2] : "mapped_file_bench.txt";
+
+  if (megabytes > 0)
+  {
+    // lines of 0-160 characters, like a typical log or CSV
+    std::ofstream out(path, std::ios::binary);
+    std::mt19937 rng(42);
+    std::string line;
+    for (size_t written = 0; written < static_cast<size_t>(megabytes) << 20; written += line.size() + 1)
+    {
+      line.assign(rng() % 161, 'a' + static_cast<char>(rng() % 26));
+      out << line << '\n';
+    }
+  }
+
+  zkl::mapped_file file(path);
+  size_t size = file.size();
+  size_t warm = 0;
+  for (size_t i = 0; i < size; i += 4096)
+    warm += static_cast<unsigned char>(file.data()[i]);
+
+  std::cout << "file: " << path << " (" << size / 1e6 << " MB)\n";
+  std::cout << "metodo\t\ttempo (ms)\tMB/s\t\trighe\n";
+
+  tally mapped = {0, 0};
+  double ms = milliseconds([&]()
+                           {
+                             for (zkl::string_view line : file.lines())
+                             {
+                               mapped.lines++;
+                               mapped.bytes += line.size();
+                             } });
+  report("mapped_file", size, ms, mapped);
+
+  tally zklTally = {0, 0};
+  ms = milliseconds([&]()
+                    {
+                      std::ifstream in(path, std::ios::binary);
+                      zkl::string line;
+                      while (zkl::getline(in, line))
+                      {
+                        zklTally.lines++;
+                        zklTally.bytes += line.size();
+                      } });
+  report("zkl::getline", size, ms, zklTally);
+
+  tally stdTally = {0, 0};
+  ms = milliseconds([&]()
+                    {
+                      std::ifstream in(path, std::ios::binary);
+                      std::string line;
+                      while (std::getline(in, line))
+                      {
+                        stdTally.lines++;
+                        stdTally.bytes += line.size();
+                      } });
+  report("std::getline", size, ms, stdTally);
+
+  file.close();
+  if (megabytes > 0)
+    std::remove(path);
+
+  doNotOptimize(warm);
+  if (mapped.lines != stdTally.lines || mapped.bytes != stdTally.bytes)
+  {
+    std::cout << "errore: i conteggi non coincidono\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @brief Benchmark di conversione numerica: `zkl::append_number`/`zkl::from_chars` contro iostream, `std::to_string`, `snprintf`, `atoi` e `strtod`.
+ *
+ * Formatta e rilegge valori casuali (interi a 64 bit di lunghezza variabile e double) come in
+ * una riga di metriche, e stampa i nanosecondi per valore di ogni metodo.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/numbers.cpp -o bench/numbers.exe
+ *
+ * Uso:
+ *   bench/numbers.exe [valori]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdio>   // Per std::snprintf
+#include <cstdlib>  // Per std::atol, std::atoll, std::strtod
+#include <iostream> // Per funzioni io
+#include <random>   // Per std::mt19937_64
+#include <sstream>  // Per std::ostringstream
+#include <string>   // Per std::to_string
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Esegue `body` e restituisce i nanosecondi per valore.
+ */
+template <typename Body>
+double nsPerValue(size_t values, Body body)
+{
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / values;
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+
+  zkl::vector<long long> integers;
+  zkl::vector<double> doubles;
+  std::mt19937_64 rng(42);
+  for (size_t i = 0; i < n; i++)
+  {
+    integers.push_back(static_cast<long long>(rng() >> (rng() % 64)) * (i % 2 ? 1 : -1));
+    doubles.push_back(static_cast<double>(rng() >> 11) / static_cast<double>(rng() | 1));
+  }
+
+  std::cout << "valori: " << n << " (ns/valore)\n";
+  std::cout << "metodo\t\t\tlong long\tdouble\n";
+
+  // every formatter writes into the same line, as when emitting metrics
+  zkl::string line;
+  double intNs = nsPerValue(n, [&]()
+                            {
+                              for (long long value : integers)
+                              {
+                                line.clear();
+                                zkl::append_number(line, value);
+                                doNotOptimize(line);
+                              } });
+  double doubleNs = nsPerValue(n, [&]()
+                               {
+                                 for (double value : doubles)
+                                 {
+                                   line.clear();
+                                   zkl::append_number(line, value);
+                                   doNotOptimize(line);
+                                 } });
+  std::cout << "zkl::append_number\t" << intNs << "\t\t" << doubleNs << "\n";
+
+  intNs = nsPerValue(n, [&]()
+                     {
+                       for (long long value : integers)
+                       {
+                         std::string s = std::to_string(value);
+                         doNotOptimize(s);
+                       } });
+  doubleNs = nsPerValue(n, [&]()
+                        {
+                          for (double value : doubles)
+                          {
+                            std::string s = std::to_string(value);
+                            doNotOptimize(s);
+                          } });
+  std::cout << "std::to_string\t\t" << intNs << "\t\t" << doubleNs << " (6 decimali, non round-trip)\n";
+
+  char buffer[64];
+  intNs = nsPerValue(n, [&]()
+                     {
+                       for (long long value : integers)
+                       {
+                         std::snprintf(buffer, sizeof(buffer), "%lld", value);
+                         doNotOptimize(buffer);
+                       } });
+  doubleNs = nsPerValue(n, [&]()
+                        {
+                          for (double value : doubles)
+                          {
+                            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+                            doNotOptimize(buffer);
+                          } });
+  std::cout << "snprintf\t\t" << intNs << "\t\t" << doubleNs << "\n";
+
+  std::ostringstream stream;
+  stream.precision(17);
+  intNs = nsPerValue(n, [&]()
+                     {
+                       for (long long value : integers)
+                       {
+                         stream.str(std::string());
+                         stream << value;
+                         doNotOptimize(stream);
+                       } });
+  doubleNs = nsPerValue(n, [&]()
+                        {
+                          for (double value : doubles)
+                          {
+                            stream.str(std::string());
+                            stream << value;
+                            doNotOptimize(stream);
+                          } });
+  std::cout << "std::ostringstream\t" << intNs << "\t\t" << doubleNs << "\n";
+
+  // parse the texts produced by zkl, which are also what the C functions expect
+  zkl::vector<zkl::string> intTexts;
+  zkl::vector<zkl::string> doubleTexts;
+  for (size_t i = 0; i < n; i++)
+  {
+    intTexts.push_back(zkl::to_string(integers[i]));
+    doubleTexts.push_back(zkl::to_string(doubles[i]));
+  }
+
+  long long intSum = 0;
+  double doubleSum = 0;
+  bool exact = true;
+  intNs = nsPerValue(n, [&]()
+                     {
+                       for (const zkl::string& text : intTexts)
+                       {
+                         long long value = 0;
+                         zkl::from_chars(text, value);
+                         intSum += value;
+                       } });
+  doubleNs = nsPerValue(n, [&]()
+                        {
+                          for (size_t i = 0; i < n; i++)
+                          {
+                            double value = 0;
+                            zkl::from_chars(doubleTexts[i], value);
+                            exact = exact && value == doubles[i];
+                          } });
+  std::cout << "zkl::from_chars\t\t" << intNs << "\t\t" << doubleNs << "\n";
+
+  intNs = nsPerValue(n, [&]()
+                     {
+                       for (const zkl::string& text : intTexts)
+                         intSum += std::atoll(text.c_str()); });
+  doubleNs = nsPerValue(n, [&]()
+                        {
+                          for (const zkl::string& text : doubleTexts)
+                            doubleSum += std::strtod(text.c_str(), nullptr); });
+  std::cout << "atoll / strtod\t\t" << intNs << "\t\t" << doubleNs << "\n";
+
+  doNotOptimize(intSum);
+  doNotOptimize(doubleSum);
+  if (!exact)
+  {
+    std::cout << "errore: un double non è stato riletto esattamente\n";
+    return 1;
+  }
+
+  return 0;
+}
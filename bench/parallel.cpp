@@ -0,0 +1,107 @@
+/**
+ * @brief Benchmark degli algoritmi di `zkl::parallel` contro le versioni sequenziali di `<algorithm>`.
+ *
+ * Su un `zkl::vector<double>` misura `for_each`, `transform`, `reduce` e `sort` e stampa i
+ * millisecondi della versione sequenziale, di quella parallela e lo speedup. Il numero di thread
+ * si sceglie con la variabile d'ambiente `ZKL_THREADS` (default: un thread per core), così la
+ * scalabilità si misura lanciando il programma più volte:
+ *   for t in 1 2 4 8 16 32; do ZKL_THREADS=$t bench/parallel.exe 100000000; done
+ *
+ * Compilazione:
+ *   g++ -O2 bench/parallel.cpp -o bench/parallel.exe -lpthread
+ *
+ * Uso:
+ *   bench/parallel.exe [elementi]
+ */
+#include "../zkl/zkl.hpp"
+#include <algorithm> // Per gli algoritmi sequenziali
+#include <chrono>    // Per std::chrono
+#include <cmath>     // Per std::sqrt
+#include <cstdlib>   // Per std::atol
+#include <iostream>  // Per funzioni io
+#include <numeric>   // Per std::accumulate
+#include <random>    // Per std::mt19937_64
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Esegue `body` e restituisce i millisecondi trascorsi.
+ */
+template <typename Body>
+double milliseconds(Body body)
+{
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Stampa una riga con i tempi sequenziale e parallelo.
+ */
+void report(const char* name, double sequential, double parallel)
+{
+  std::cout << name << "\t" << sequential << "\t" << parallel << "\t" << sequential / parallel << "x\n";
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 20000000;
+
+  zkl::vector<double> data;
+  data.resize(n);
+  std::mt19937_64 rng(42);
+  for (double& x : data)
+    x = static_cast<double>(rng() >> 11);
+  zkl::vector<double> out;
+  out.resize(n);
+
+  std::cout << "elementi: " << n << ", thread: " << zkl::parallel::thread_pool::global().size() + 1 << "\n";
+  std::cout << "algoritmo\tsequenziale (ms)\tparallelo (ms)\tspeedup\n";
+
+  auto step = [](double& x)
+  { x = std::sqrt(x) + 1.0; };
+  double sequential = milliseconds([&]()
+                                   { std::for_each(data.begin(), data.end(), step); });
+  double parallel = milliseconds([&]()
+                                 { zkl::parallel::for_each(data, step); });
+  report("for_each", sequential, parallel);
+
+  auto scale = [](double x)
+  { return x * 0.5 + 3.0; };
+  sequential = milliseconds([&]()
+                            { std::transform(data.begin(), data.end(), out.begin(), scale); });
+  parallel = milliseconds([&]()
+                          { zkl::parallel::transform(data, out, scale); });
+  report("transform", sequential, parallel);
+
+  double sum = 0;
+  sequential = milliseconds([&]()
+                            { sum += std::accumulate(data.begin(), data.end(), 0.0); });
+  parallel = milliseconds([&]()
+                          { sum += zkl::parallel::reduce(data, 0.0); });
+  doNotOptimize(sum);
+  report("reduce", sequential, parallel);
+
+  zkl::vector<double> copy(data);
+  sequential = milliseconds([&]()
+                            { std::sort(data.begin(), data.end()); });
+  parallel = milliseconds([&]()
+                          { zkl::parallel::sort(copy); });
+  report("sort", sequential, parallel);
+
+  if (!std::equal(data.begin(), data.end(), copy.begin()))
+  {
+    std::cout << "errore: i risultati di sort non coincidono\n";
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @brief Benchmark di throughput e latenza di `zkl::spsc_ring` e `zkl::mpmc_ring` contro una
+ * `std::deque` protetta da mutex.
+ *
+ * Per 1, 2, 4, 8 e 16 produttori e altrettanti consumatori ogni produttore invia lo stesso numero
+ * di messaggi, uno alla volta o a blocchi con `push_n`/`pop_n`. Ogni messaggio porta l'istante di
+ * invio, così i consumatori misurano la latenza media e il 99° percentile; il throughput è calcolato
+ * sul tempo totale dall'avvio all'ultimo `join`. La coda SPSC compare solo nella riga a 1 thread.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/ring.cpp -o bench/ring.exe -lpthread
+ *
+ * Uso:
+ *   bench/ring.exe [messaggi per produttore] [capacità]
+ */
+#include "../zkl/zkl.hpp"
+#include <algorithm> // Per std::sort
+#include <chrono>    // Per std::chrono
+#include <cstdlib>   // Per std::atol
+#include <deque>     // Per std::deque
+#include <iostream>  // Per funzioni io
+#include <mutex>     // Per std::mutex
+#include <thread>    // Per std::thread
+
+/**
+ * @brief Messaggio scambiato tra produttori e consumatori.
+ */
+struct message
+{
+  long sent; /**< Istante di invio in nanosecondi. */
+  long value;
+};
+
+/**
+ * @brief Dimensione dei blocchi usati da `push_n`/`pop_n`.
+ */
+const size_t batch = 32;
+
+/**
+ * @brief Istante corrente in nanosecondi.
+ */
+long now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Risultato di una misura.
+ */
+struct result
+{
+  double mops;      /**< Milioni di messaggi al secondo. */
+  double averageNs; /**< Latenza media. */
+  double p99Ns;     /**< Latenza al 99° percentile. */
+};
+
+/**
+ * @brief Avvia `threads` produttori e `threads` consumatori su una coda.
+ *
+ * `push(message* first, size_t count)` e `pop(message* out, size_t count)` restituiscono quanti
+ * messaggi hanno trasferito; quando non trasferiscono nulla il thread cede il processore.
+ */
+template <typename Push, typename Pop>
+result measure(int threads, long messages, size_t block, Push push, Pop pop)
+{
+  long total = messages * threads;
+  std::atomic<long> received(0);
+  zkl::vector<zkl::vector<long>> latencies;
+  latencies.resize(threads);
+  zkl::vector<std::thread> workers;
+
+  long start = now();
+  for (int t = 0; t < threads; t++)
+  {
+    workers.emplace_back([&, t]()
+                         {
+                           message buffer[batch];
+                           for (long i = 0; i < messages;)
+                           {
+                             size_t count = std::min<long>(block, messages - i);
+                             long sent = now();
+                             for (size_t j = 0; j < count; j++)
+                               buffer[j] = message{sent, t * messages + i + static_cast<long>(j)};
+                             size_t pushed = push(buffer, count);
+                             i += pushed;
+                             if (pushed < count)
+                               std::this_thread::yield();
+                           } });
+    workers.emplace_back([&, t]()
+                         {
+                           message buffer[batch];
+                           latencies[t].reserve(total / threads + batch);
+                           while (received.load(std::memory_order_relaxed) < total)
+                           {
+                             size_t popped = pop(buffer, block);
+                             if (popped == 0)
+                             {
+                               std::this_thread::yield();
+                               continue;
+                             }
+                             long arrived = now();
+                             for (size_t j = 0; j < popped; j++)
+                               latencies[t].push_back(arrived - buffer[j].sent);
+                             received.fetch_add(popped, std::memory_order_relaxed);
+                           } });
+  }
+  for (std::thread& worker : workers)
+    worker.join();
+  long end = now();
+
+  zkl::vector<long> all;
+  all.reserve(total);
+  for (const zkl::vector<long>& partial : latencies)
+    for (long latency : partial)
+      all.push_back(latency);
+  std::sort(all.begin(), all.end());
+
+  double sum = 0;
+  for (long latency : all)
+    sum += latency;
+
+  return result{total * 1e3 / (end - start), sum / all.size(), static_cast<double>(all[all.size() * 99 / 100])};
+}
+
+/**
+ * @brief Stampa una riga della tabella.
+ */
+void report(int threads, const char* queue, size_t block, const result& r)
+{
+  std::cout << threads << "\t" << queue << "\t" << block << "\t" << r.mops << "\t\t" << r.averageNs << "\t\t" << r.p99Ns << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  long messages = argc > 1 ? std::atol(argv[1]) : 200000;
+  size_t capacity = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 1024;
+
+  std::cout << "messaggi per produttore: " << messages << ", capacità: " << capacity << "\n";
+  std::cout << "thread\tcoda\t\tblocco\tMmsg/s\t\tmedia (ns)\tp99 (ns)\n";
+
+  for (int threads = 1; threads <= 16; threads *= 2)
+  {
+    for (size_t block : {static_cast<size_t>(1), batch})
+    {
+      std::deque<message> deque;
+      std::mutex mutex;
+      report(threads, "mutex+deque", block, measure(threads, messages, block, [&](message* first, size_t count)
+                                                    {
+                                                      std::lock_guard<std::mutex> lock(mutex);
+                                                      size_t pushed = std::min(count, capacity - deque.size());
+                                                      deque.insert(deque.end(), first, first + pushed);
+                                                      return pushed; },
+                                                    [&](message* out, size_t count)
+                                                    {
+                                                      std::lock_guard<std::mutex> lock(mutex);
+                                                      size_t popped = std::min(count, deque.size());
+                                                      std::copy(deque.begin(), deque.begin() + popped, out);
+                                                      deque.erase(deque.begin(), deque.begin() + popped);
+                                                      return popped; }));
+
+      if (threads == 1)
+      {
+        zkl::spsc_ring<message> spsc(capacity);
+        report(threads, "spsc_ring", block, measure(threads, messages, block, [&](message* first, size_t count)
+                                                    { return spsc.push_n(first, count); },
+                                                    [&](message* out, size_t count)
+                                                    { return spsc.pop_n(out, count); }));
+      }
+
+      zkl::mpmc_ring<message> mpmc(capacity);
+      report(threads, "mpmc_ring", block, measure(threads, messages, block, [&](message* first, size_t count)
+                                                  { return block == 1 ? static_cast<size_t>(mpmc.try_push(*first)) : mpmc.push_n(first, count); },
+                                                  [&](message* out, size_t count)
+                                                  { return block == 1 ? static_cast<size_t>(mpmc.try_pop(*out)) : mpmc.pop_n(out, count); }));
+    }
+  }
+
+  return 0;
+}
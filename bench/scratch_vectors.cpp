@@ -0,0 +1,93 @@
+/**
+ * @brief Benchmark di vettori temporanei "per richiesta" con diversi allocatori.
+ *
+ * Ogni richiesta simulata crea alcuni `zkl::vector` di lunghezza variabile, li riempie e li
+ * distrugge alla fine. Si confronta il tempo medio per richiesta con:
+ * - `std::allocator` (heap globale);
+ * - `zkl::pmr::vector` su una `zkl::monotonic_arena` rilasciata a fine richiesta, con un buffer iniziale sullo stack;
+ * - `zkl::pool_allocator`, che riusa i blocchi liberati tra una richiesta e l'altra.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/scratch_vectors.cpp -o bench/scratch_vectors.exe
+ *
+ * Uso:
+ *   bench/scratch_vectors.exe [richieste]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atol
+#include <iostream> // Per funzioni io
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/** Numero di vettori temporanei creati da ogni richiesta. */
+const size_t vectorsPerRequest = 8;
+
+/**
+ * @brief Simula una richiesta: riempie `vectorsPerRequest` vettori creati con `allocator`.
+ *
+ * @param request Indice della richiesta, usato per variare le lunghezze.
+ * @param allocator L'allocatore dei vettori.
+ * @return Una somma degli elementi, per non far eliminare il lavoro.
+ */
+template <typename Vector, typename Allocator>
+long handleRequest(long request, const Allocator& allocator)
+{
+  long sum = 0;
+  for (size_t i = 0; i < vectorsPerRequest; i++)
+  {
+    Vector scratch(allocator);
+    long length = 16 + (request * 7 + static_cast<long>(i) * 13) % 240;
+    for (long j = 0; j < length; j++)
+      scratch.push_back(j ^ request);
+    sum += scratch[scratch.size() / 2];
+  }
+  return sum;
+}
+
+/**
+ * @brief Esegue `requests` richieste con `body` e stampa i nanosecondi medi per richiesta.
+ */
+template <typename Body>
+void measure(const char* name, long requests, Body body)
+{
+  long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long r = 0; r < requests; r++)
+    sum += body(r);
+  auto end = std::chrono::steady_clock::now();
+
+  doNotOptimize(sum);
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / requests;
+  std::cout << name << "\t" << ns << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  long requests = argc > 1 ? std::atol(argv[1]) : 200000;
+
+  std::cout << "richieste: " << requests << ", vettori per richiesta: " << vectorsPerRequest << "\n";
+  std::cout << "allocatore\t\tns/richiesta\n";
+
+  measure("std::allocator", requests, [](long r)
+          { return handleRequest<zkl::vector<long>>(r, std::allocator<long>()); });
+
+  measure("monotonic_arena", requests, [](long r)
+          {
+            char buffer[32768];
+            zkl::monotonic_arena arena(buffer, sizeof(buffer));
+            return handleRequest<zkl::pmr::vector<long>>(r, std::pmr::polymorphic_allocator<long>(&arena)); });
+
+  zkl::pool_allocator<long> pool;
+  measure("pool_allocator", requests, [&](long r)
+          { return handleRequest<zkl::vector<long, zkl::growth_policy<>, zkl::pool_allocator<long>>>(r, pool); });
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @brief Benchmark del costo di copia di `zkl::shared_string` al variare del numero di thread.
+ *
+ * Ogni thread copia e distrugge ripetutamente la stessa stringa (una configurazione di 64 caratteri,
+ * quindi oltre la small-string optimization) e si misura il tempo medio per copia. Confronta:
+ * - `zkl::shared_string`: la copia incrementa un contatore atomico condiviso da tutti i thread;
+ * - `zkl::string`: la copia alloca e copia i caratteri;
+ * - `std::string`: come riferimento.
+ *
+ * Compilazione:
+ *   g++ -O2 -pthread bench/shared_string.cpp -o bench/shared_string.exe
+ *
+ * Uso:
+ *   bench/shared_string.exe [copie per thread]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atoi
+#include <iostream> // Per funzioni io
+#include <string>   // Per std::string
+#include <thread>   // Per std::thread
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Misura il tempo medio di una copia con `threads` thread che copiano la stessa sorgente.
+ *
+ * @param source La stringa condivisa da tutti i thread.
+ * @param threads Numero di thread.
+ * @param copies Numero di copie eseguite da ciascun thread.
+ * @return Nanosecondi per copia, misurati per thread.
+ */
+template <typename String>
+double measureCopies(const String& source, unsigned threads, long copies)
+{
+  std::thread* workers = new std::thread[threads];
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < threads; t++)
+  {
+    workers[t] = std::thread([&source, copies]()
+                             {
+                               for (long i = 0; i < copies; i++)
+                               {
+                                 String copy(source);
+                                 doNotOptimize(copy);
+                               } });
+  }
+  for (unsigned t = 0; t < threads; t++)
+    workers[t].join();
+  auto end = std::chrono::steady_clock::now();
+
+  delete[] workers;
+
+  double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  return ns / copies;
+}
+
+int main(int argc, char** argv)
+{
+  long copies = argc > 1 ? std::atol(argv[1]) : 2000000;
+  const char* text = "service.worker.config.label=some-moderately-long-value-0123456789";
+
+  zkl::shared_string shared(text);
+  zkl::string owned(text);
+  std::string standard(text);
+
+  std::cout << "copie per thread: " << copies << ", hardware threads: " << std::thread::hardware_concurrency() << "\n";
+  std::cout << "threads\tshared_string ns/copy\tzkl::string ns/copy\tstd::string ns/copy\n";
+
+  for (unsigned threads = 1; threads <= 16; threads *= 2)
+  {
+    double sharedNs = measureCopies(shared, threads, copies);
+    double ownedNs = measureCopies(owned, threads, copies);
+    double standardNs = measureCopies(standard, threads, copies);
+    std::cout << threads << "\t" << sharedNs << "\t\t\t" << ownedNs << "\t\t\t" << standardNs << "\n";
+  }
+
+  return 0;
+}
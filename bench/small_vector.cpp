@@ -0,0 +1,68 @@
+/**
+ * @brief Benchmark di liste corte per elemento: `zkl::small_vector` contro `zkl::vector` e `std::vector`.
+ *
+ * Per ogni elemento si costruisce una lista di 0–8 interi, la si legge e la si distrugge, come le
+ * liste di adiacenza o di attributi che vivono in un ciclo caldo. Si stampa il tempo medio per
+ * lista; `zkl::small_vector<int, 8>` non alloca mai, mentre gli altri allocano fino a 4 volte.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/small_vector.cpp -o bench/small_vector.exe
+ *
+ * Uso:
+ *   bench/small_vector.exe [liste]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atol
+#include <iostream> // Per funzioni io
+#include <vector>   // Per std::vector
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Costruisce e somma `lists` liste di lunghezza 0–8 e stampa i nanosecondi medi per lista.
+ *
+ * @param name Nome del contenitore.
+ * @param lists Numero di liste da costruire.
+ */
+template <typename List>
+void measure(const char* name, long lists)
+{
+  long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < lists; i++)
+  {
+    List list;
+    long length = (i * 7) % 9;
+    for (long j = 0; j < length; j++)
+      list.push_back(static_cast<int>(i + j));
+    for (size_t j = 0; j < list.size(); j++)
+      sum += list[j];
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  doNotOptimize(sum);
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / lists;
+  std::cout << name << "\t" << ns << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  long lists = argc > 1 ? std::atol(argv[1]) : 5000000;
+
+  std::cout << "liste: " << lists << " (0-8 elementi)\n";
+  std::cout << "contenitore\t\tns/lista\n";
+
+  measure<zkl::small_vector<int, 8>>("zkl::small_vector<int, 8>", lists);
+  measure<zkl::vector<int>>("zkl::vector<int>", lists);
+  measure<std::vector<int>>("std::vector<int>", lists);
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @brief Benchmark di tokenizzazione: `zkl::split` contro il ciclo `find` + `substr`.
+ *
+ * Divide un testo in stile CSV (campi di 0-12 caratteri) e stampa i nanosecondi per campo con
+ * `find` + `substr` su `zkl::string` (una stringa per campo) e con `zkl::split` per delimitatore
+ * singolo, sequenza di caratteri e insieme di caratteri.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/split.cpp -o bench/split.exe
+ *
+ * Uso:
+ *   bench/split.exe [campi] [ripetizioni]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atol
+#include <iostream> // Per funzioni io
+#include <random>   // Per std::mt19937
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Esegue `body` `rounds` volte e restituisce i nanosecondi per campo.
+ */
+template <typename Body>
+double nsPerField(long rounds, long fields, Body body)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (long r = 0; r < rounds; r++)
+    body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / (rounds * fields);
+}
+
+int main(int argc, char** argv)
+{
+  long fields = argc > 1 ? std::atol(argv[1]) : 100000;
+  long rounds = argc > 2 ? std::atol(argv[2]) : 20;
+
+  zkl::string text;
+  zkl::string separated;
+  std::mt19937 rng(42);
+  for (long i = 0; i < fields; i++)
+  {
+    zkl::string field;
+    field.append(rng() % 13, static_cast<char>('a' + rng() % 26));
+    text += field;
+    separated += field;
+    if (i + 1 < fields)
+    {
+      text += ',';
+      separated += ", ";
+    }
+  }
+
+  std::cout << "campi: " << fields << " (ns/campo)\n";
+
+  size_t total = 0;
+  double ns = nsPerField(rounds, fields, [&]()
+                         {
+                           size_t start = 0;
+                           for (;;)
+                           {
+                             size_t comma = text.find(',', start);
+                             zkl::string field = text.substr(start, comma == zkl::string::npos ? zkl::string::npos : comma - start);
+                             total += field.size();
+                             if (comma == zkl::string::npos)
+                               break;
+                             start = comma + 1;
+                           } });
+  std::cout << "find + substr\t\t" << ns << "\n";
+
+  ns = nsPerField(rounds, fields, [&]()
+                  {
+                    for (zkl::string_view field : text.split(','))
+                      total += field.size(); });
+  std::cout << "split(char)\t\t" << ns << "\n";
+
+  ns = nsPerField(rounds, fields, [&]()
+                  {
+                    for (zkl::string_view field : separated.split(", "))
+                      total += field.size(); });
+  std::cout << "split(\", \")\t\t" << ns << "\n";
+
+  zkl::char_set delimiters(",;|", 3);
+  ns = nsPerField(rounds, fields, [&]()
+                  {
+                    for (zkl::string_view field : text.split(delimiters))
+                      total += field.size(); });
+  std::cout << "split(char_set)\t\t" << ns << "\n";
+
+  doNotOptimize(total);
+  return 0;
+}
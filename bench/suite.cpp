@@ -0,0 +1,370 @@
+/**
+ * @brief Suite di benchmark di `zkl::string` e `zkl::vector` contro `std::string` e `std::vector`.
+ *
+ * Per ogni operazione e per ogni dimensione da 8 B alla dimensione massima (moltiplicando per 8)
+ * esegue l'operazione abbastanza volte da superare il tempo minimo e riporta ns/op, byte/s e
+ * allocazioni/op per entrambe le implementazioni. Le allocazioni si contano sostituendo
+ * `operator new` globale, quindi valgono per qualunque allocazione fatta durante la misura.
+ *
+ * Operazioni:
+ *   string.append       costruisce la stringa con append da 16 byte
+ *   string.push_back    costruisce la stringa un carattere alla volta
+ *   string.find_char    cerca un carattere presente solo in fondo
+ *   string.find         cerca una sottostringa presente solo in fondo
+ *   string.rfind        cerca all'indietro una sottostringa presente solo all'inizio
+ *   string.find_first_of cerca il primo di 4 caratteri, presenti solo in fondo
+ *   string.insert       inserisce 8 byte a metà (poi tronca in fondo)
+ *   string.erase        cancella 8 byte a metà (poi li riaggiunge in fondo)
+ *   string.replace      sostituisce 8 byte a metà con 16 (poi tronca in fondo)
+ *   string.copy         costruttore di copia
+ *   string.move         spostamento avanti e indietro
+ *   string.getline      legge righe di 64 byte da un std::istringstream
+ *   vector.push_back    costruisce un vettore di long long senza reserve
+ *   vector.copy         costruttore di copia
+ *   vector.move         spostamento avanti e indietro
+ *
+ * Compilazione (oppure il task "C/C++: gcc build benchmark suite" di VS Code):
+ *   g++ -O2 -DNDEBUG bench/suite.cpp -o bench/suite.exe
+ *
+ * Uso:
+ *   bench/suite.exe [--max-size byte] [--min-time ms] [--filter testo] [--json file]
+ *
+ * La dimensione massima predefinita è 16 MiB; `--max-size 1073741824` arriva a 1 GiB, ma richiede
+ * qualche GiB di memoria libera. Con `--json` i risultati vengono scritti anche in un file, per
+ * confrontare esecuzioni diverse.
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::malloc, std::free, std::atol
+#include <cstring>  // Per std::strcmp, std::strstr
+#include <fstream>  // Per std::ofstream
+#include <iostream> // Per funzioni io
+#include <new>      // Per std::bad_alloc
+#include <sstream>  // Per std::istringstream
+#include <string>   // Per std::string
+#include <vector>   // Per std::vector
+
+/**
+ * @brief Numero di chiamate a `operator new` dall'avvio del programma.
+ */
+static size_t allocations = 0;
+
+void* operator new(size_t size)
+{
+  allocations++;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+/**
+ * @brief Impedisce al compilatore di eliminare un valore calcolato ma non usato.
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Risultato di una misura.
+ */
+struct measurement
+{
+  const char* operation;      /**< Nome dell'operazione. */
+  const char* implementation; /**< "zkl" o "std". */
+  size_t bytes;               /**< Byte elaborati da un'operazione. */
+  size_t iterations;          /**< Operazioni misurate. */
+  double nsPerOp;             /**< Nanosecondi per operazione. */
+  double bytesPerSecond;      /**< Byte elaborati al secondo. */
+  double allocationsPerOp;    /**< Chiamate a `operator new` per operazione. */
+};
+
+/**
+ * @brief Opzioni della riga di comando.
+ */
+struct options
+{
+  size_t maxSize = 16 << 20;    /**< Dimensione massima dei dati. */
+  double minTime = 100;         /**< Millisecondi minimi per misura. */
+  const char* filter = nullptr; /**< Se presente, solo le operazioni che lo contengono. */
+  const char* json = nullptr;   /**< Se presente, file in cui scrivere i risultati. */
+};
+
+static options settings;
+static zkl::vector<measurement> results;
+
+/**
+ * @brief Esegue `body` `iterations` volte e restituisce i nanosecondi trascorsi.
+ */
+template <typename Body>
+double run(size_t iterations, Body& body)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    body();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * @brief Misura `body`, raddoppiando le ripetizioni finché non si supera il tempo minimo, e stampa il risultato.
+ *
+ * @param operation Nome dell'operazione.
+ * @param implementation "zkl" o "std".
+ * @param bytes Byte elaborati da una chiamata di `body`.
+ * @param body L'operazione da misurare.
+ */
+template <typename Body>
+void measure(const char* operation, const char* implementation, size_t bytes, Body body)
+{
+  if (settings.filter && !std::strstr(operation, settings.filter))
+    return;
+
+  double minimum = settings.minTime * 1e6;
+  size_t iterations = 1;
+  double elapsed;
+  size_t allocated;
+  for (;;)
+  {
+    size_t before = allocations;
+    elapsed = run(iterations, body);
+    allocated = allocations - before;
+    if (elapsed >= minimum)
+      break;
+
+    // jump straight to the estimated count, doubling at most 100 times per round
+    double scale = elapsed > 0 ? minimum / elapsed * 1.2 : 100;
+    iterations = static_cast<size_t>(iterations * (scale < 2 ? 2 : scale > 100 ? 100 : scale));
+  }
+
+  measurement m{operation, implementation, bytes, iterations, elapsed / iterations, bytes * iterations / (elapsed / 1e9), static_cast<double>(allocated) / iterations};
+  results.push_back(m);
+  std::cout << m.operation << "\t" << m.implementation << "\t" << m.bytes << "\t" << m.nsPerOp << "\t" << m.bytesPerSecond / 1e6 << "\t" << m.allocationsPerOp << "\n";
+}
+
+/**
+ * @brief Costruisce una stringa di `size` lettere minuscole, quindi senza i caratteri cercati dai benchmark.
+ */
+template <typename String>
+String filler(size_t size)
+{
+  String s;
+  for (size_t i = 0; i < size; i++)
+    s.push_back(static_cast<char>('a' + i % 23));
+  return s;
+}
+
+/**
+ * @brief Misura le operazioni su stringhe di `size` byte per un tipo di stringa.
+ */
+template <typename String>
+void stringOperations(const char* implementation, size_t size)
+{
+  const char chunk[] = "0123456789abcdef";
+  const char* needle = "XYZ!";
+
+  measure("string.append", implementation, size, [&]()
+          {
+            String s;
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+              s.append(chunk, 16);
+            s.append(chunk, size - i);
+            doNotOptimize(s); });
+
+  measure("string.push_back", implementation, size, [&]()
+          {
+            String s;
+            for (size_t i = 0; i < size; i++)
+              s.push_back('x');
+            doNotOptimize(s); });
+
+  String text = filler<String>(size);
+  String tail = text;
+  tail.replace(size - 4, 4, needle);
+  String head = text;
+  head.replace(0, 4, needle);
+
+  measure("string.find_char", implementation, size, [&]()
+          {
+            size_t pos = tail.find('!');
+            doNotOptimize(pos); });
+
+  measure("string.find", implementation, size, [&]()
+          {
+            size_t pos = tail.find(needle);
+            doNotOptimize(pos); });
+
+  measure("string.rfind", implementation, size, [&]()
+          {
+            size_t pos = head.rfind(needle);
+            doNotOptimize(pos); });
+
+  measure("string.find_first_of", implementation, size, [&]()
+          {
+            size_t pos = tail.find_first_of("XYZ!");
+            doNotOptimize(pos); });
+
+  String work = text;
+  size_t middle = size / 2;
+
+  measure("string.insert", implementation, size, [&]()
+          {
+            work.insert(middle, chunk, 8);
+            work.erase(size);
+            doNotOptimize(work); });
+
+  measure("string.erase", implementation, size, [&]()
+          {
+            work.erase(middle, 8);
+            work.append(chunk, 8);
+            doNotOptimize(work); });
+
+  measure("string.replace", implementation, size, [&]()
+          {
+            work.replace(middle, 8, chunk, 16);
+            work.erase(size);
+            doNotOptimize(work); });
+
+  measure("string.copy", implementation, size, [&]()
+          {
+            String copy(text);
+            doNotOptimize(copy); });
+
+  measure("string.move", implementation, size, [&]()
+          {
+            String moved(std::move(text));
+            text = std::move(moved);
+            doNotOptimize(text); });
+
+  std::string lines;
+  for (size_t i = 0; i < size; i++)
+    lines.push_back(i % 64 == 63 ? '\n' : static_cast<char>('a' + i % 23));
+  std::istringstream input(lines);
+  String line;
+
+  measure("string.getline", implementation, size, [&]()
+          {
+            input.clear();
+            input.seekg(0);
+            while (getline(input, line))
+              doNotOptimize(line); });
+}
+
+/**
+ * @brief Misura le operazioni su vettori di `size` byte per un tipo di vettore.
+ */
+template <typename Vector>
+void vectorOperations(const char* implementation, size_t size)
+{
+  size_t count = size / sizeof(long long);
+  if (count == 0)
+    return;
+
+  measure("vector.push_back", implementation, size, [&]()
+          {
+            Vector v;
+            for (size_t i = 0; i < count; i++)
+              v.push_back(static_cast<long long>(i));
+            doNotOptimize(v); });
+
+  Vector data;
+  for (size_t i = 0; i < count; i++)
+    data.push_back(static_cast<long long>(i));
+
+  measure("vector.copy", implementation, size, [&]()
+          {
+            Vector copy(data);
+            doNotOptimize(copy); });
+
+  measure("vector.move", implementation, size, [&]()
+          {
+            Vector moved(std::move(data));
+            data = std::move(moved);
+            doNotOptimize(data); });
+}
+
+/**
+ * @brief Scrive i risultati in formato JSON.
+ */
+void writeJson(std::ostream& out)
+{
+  out << "{\n  \"compiler\": \"" << __VERSION__ << "\",\n  \"max_size\": " << settings.maxSize << ",\n  \"min_time_ms\": " << settings.minTime << ",\n  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const measurement& m = results[i];
+    out << (i ? ",\n" : "\n") << "    {\"operation\": \"" << m.operation << "\", \"implementation\": \"" << m.implementation << "\", \"bytes\": " << m.bytes
+        << ", \"iterations\": " << m.iterations << ", \"ns_per_op\": " << m.nsPerOp << ", \"bytes_per_second\": " << m.bytesPerSecond
+        << ", \"allocations_per_op\": " << m.allocationsPerOp << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv)
+{
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    if (!std::strcmp(argv[i], "--max-size"))
+      settings.maxSize = static_cast<size_t>(std::atol(argv[i + 1]));
+    else if (!std::strcmp(argv[i], "--min-time"))
+      settings.minTime = std::atof(argv[i + 1]);
+    else if (!std::strcmp(argv[i], "--filter"))
+      settings.filter = argv[i + 1];
+    else if (!std::strcmp(argv[i], "--json"))
+      settings.json = argv[i + 1];
+    else
+    {
+      std::cerr << "opzione sconosciuta: " << argv[i] << "\n";
+      return 1;
+    }
+  }
+
+  std::cout << "operazione\timpl.\tbyte\tns/op\tMB/s\tallocazioni/op\n";
+
+  for (size_t size = 8; size <= settings.maxSize; size *= 8)
+  {
+    stringOperations<zkl::string>("zkl", size);
+    stringOperations<std::string>("std", size);
+    vectorOperations<zkl::vector<long long>>("zkl", size);
+    vectorOperations<std::vector<long long>>("std", size);
+  }
+
+  if (settings.json)
+  {
+    std::ofstream file(settings.json);
+    if (!file)
+    {
+      std::cerr << "impossibile scrivere " << settings.json << "\n";
+      return 1;
+    }
+    writeJson(file);
+  }
+
+  return 0;
+}
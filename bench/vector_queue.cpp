@@ -0,0 +1,103 @@
+/**
+ * @brief Benchmark di una coda a stato stazionario su `zkl::vector` con diverse politiche di capacità.
+ *
+ * Il vettore viene riempito fino a una potenza di 2 e poi alterna `push_back` e `pop_back` attorno
+ * a quella soglia, come una coda di lavoro che resta mediamente piena. Per ogni politica si contano
+ * le riallocazioni (cambi di capacità) durante la fase stazionaria e il tempo medio per operazione:
+ * - `growth_policy<>`: raddoppio e riduzione con isteresi (default);
+ * - `growth_policy<3, 2>`: crescita di 1.5×, con isteresi;
+ * - `growth_policy<2, 1, false>`: nessuna riduzione automatica;
+ * - `halving_policy`: la vecchia politica, che dimezzava la capacità appena la dimensione scendeva
+ *   sotto la metà, per confronto.
+ *
+ * Compilazione:
+ *   g++ -O2 bench/vector_queue.cpp -o bench/vector_queue.exe
+ *
+ * Uso:
+ *   bench/vector_queue.exe [operazioni]
+ */
+#include "../zkl/zkl.hpp"
+#include <chrono>   // Per std::chrono
+#include <cstdlib>  // Per std::atol
+#include <iostream> // Per funzioni io
+
+/**
+ * @brief La politica precedente: raddoppia quando è pieno, dimezza appena la dimensione scende sotto la metà.
+ */
+struct halving_policy
+{
+  static size_t grow(size_t capacity, size_t required)
+  {
+    size_t grown = capacity == 0 ? 1 : capacity * 2;
+    return grown < required ? required : grown;
+  }
+
+  static size_t shrink(size_t size, size_t capacity)
+  {
+    size_t half = capacity / 2;
+    return (size < half && half >= 1) ? half : capacity;
+  }
+};
+
+/**
+ * @brief Esegue la coda stazionaria e stampa riallocazioni e ns/op.
+ *
+ * @param name Nome della politica.
+ * @param threshold La potenza di 2 attorno a cui oscilla la dimensione.
+ * @param operations Numero di operazioni della fase stazionaria.
+ */
+template <typename Policy>
+void measure(const char* name, size_t threshold, long operations)
+{
+  zkl::vector<long, Policy> queue;
+  for (size_t i = 0; i < threshold; i++)
+    queue.push_back(static_cast<long>(i));
+
+  // the first crossing of the threshold has to grow once; steady state starts after it
+  queue.push_back(0);
+  queue.pop_back();
+
+  size_t reallocations = 0;
+  size_t capacity = queue.capacity();
+
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < operations; i += 2)
+  {
+    queue.push_back(i);
+    if (queue.capacity() != capacity)
+    {
+      reallocations++;
+      capacity = queue.capacity();
+    }
+
+    queue.pop_back();
+    queue.pop_back();
+    if (queue.capacity() != capacity)
+    {
+      reallocations++;
+      capacity = queue.capacity();
+    }
+
+    queue.push_back(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / (operations * 2);
+  std::cout << name << "\t" << reallocations << "\t\t" << ns << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  long operations = argc > 1 ? std::atol(argv[1]) : 2000000;
+  const size_t threshold = 1024;
+
+  std::cout << "operazioni: " << operations << ", soglia: " << threshold << "\n";
+  std::cout << "politica\t\triallocazioni\tns/op\n";
+
+  measure<zkl::growth_policy<>>("growth_policy<>", threshold, operations);
+  measure<zkl::growth_policy<3, 2>>("growth_policy<3, 2>", threshold, operations);
+  measure<zkl::growth_policy<2, 1, false>>("no auto-shrink", threshold, operations);
+  measure<halving_policy>("halving (old)", threshold, operations);
+
+  return 0;
+}
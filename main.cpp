@@ -113,7 +113,6 @@
  * classe `zkl::string`, assicurandosi che si comporti in modo simile a `std::string`.
  */
 #include "zkl/zkl.hpp"
-#include <cstdlib>   // Per std::atoi
 #include <iostream>  // Per funzioni io
 #include <limits>    // Per std::numeric_limits
 #include <stdexcept> // Per std::invalid_argument
@@ -157,7 +156,7 @@ void flushInput()
 /**
  * @brief Mette in pausa il programma fino l'invio.
  */
-void pause()
+void waitForEnter()
 {
   std::cout << std::endl;
   std::cout << "Premere 'invio' per continuare..." << std::endl;
@@ -166,13 +165,27 @@ void pause()
 
 /**
  * @brief Prende dall'utente un input intero.
- * @return Il valore messo dall'utente. Se invalido, restituisce 0.
+ *
+ * Accetta un segno '+' iniziale; i caratteri dopo il numero vengono ignorati.
+ *
+ * @return Il valore messo dall'utente. Se invalido o fuori dal range di `int`, restituisce 0.
  */
 int getInt()
 {
   zkl::string line;
   zkl::getline(std::cin, line);
-  return std::atoi(line.c_str());
+
+  // zkl::from_chars, like std::from_chars, rejects a leading '+'
+  const char* first = line.data();
+  const char* last = first + line.size();
+  if (first != last && *first == '+' && last - first > 1 && first[1] >= '0' && first[1] <= '9')
+    first++;
+
+  int value = 0;
+  if (zkl::from_chars(first, last, value).ec != std::errc())
+    return 0;
+
+  return value;
 }
 
 int main()
@@ -192,10 +205,10 @@ int main()
 
     std::cout << std::endl;
 
-    if (choice >= 2 && choice <= 10 && mainStr.c_str() == nullptr)
+    if (choice >= 2 && choice <= 10 && mainStr.empty())
     {
       std::cout << "Devi impostare prima la stringa principale selezionando l'opzione 1!" << std::endl;
-      pause();
+      waitForEnter();
       continue;
     }
 
@@ -330,7 +343,7 @@ int main()
 
     if (choice != 11)
     {
-      pause();
+      waitForEnter();
     }
   }
 
@@ -0,0 +1,180 @@
+/**
+ * @brief Test di regressione di `zkl::concurrent_vector`.
+ *
+ * Ogni controllo fallito stampa la riga e il programma termina con codice 1.
+ *
+ * Compilazione:
+ *   g++ -g -fsanitize=address,undefined tests/concurrent_vector.cpp -o tests/concurrent_vector.exe -lpthread
+ *
+ * Uso:
+ *   tests/concurrent_vector.exe
+ */
+#include "../zkl/zkl.hpp"
+#include <cstddef>   // Per size_t
+#include <iostream>  // Per funzioni io
+#include <stdexcept> // Per std::runtime_error
+#include <thread>    // Per std::thread
+#include <vector>    // Per std::vector
+
+static int failures = 0;
+
+#define CHECK(condition)                                                   \
+  do                                                                       \
+  {                                                                        \
+    if (!(condition))                                                      \
+    {                                                                      \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition << "\n"; \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+/**
+ * @brief Elemento il cui costruttore lancia un'eccezione per i valori negativi.
+ */
+struct picky
+{
+  int value;
+
+  explicit picky(int v) : value(v)
+  {
+    if (v < 0)
+      throw std::runtime_error("negative value");
+  }
+};
+
+/**
+ * @brief Un `emplace_back` che lancia non deve lasciare un indice visibile da `size()` o dagli iteratori.
+ */
+static void testThrowingConstructor()
+{
+  zkl::concurrent_vector<picky> vector;
+  for (int i = 0; i < 200; i++)
+  {
+    try
+    {
+      vector.emplace_back(i % 7 == 3 ? -1 : i);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+  }
+
+  size_t expected = 0;
+  for (int i = 0; i < 200; i++)
+  {
+    if (i % 7 != 3)
+      expected++;
+  }
+  CHECK(vector.size() == expected);
+  CHECK(!vector.empty());
+
+  size_t visited = 0;
+  int previous = -1;
+  for (const picky& element : vector)
+  {
+    CHECK(element.value >= 0 && element.value % 7 != 3);
+    CHECK(element.value > previous);
+    previous = element.value;
+    visited++;
+  }
+  CHECK(visited == expected);
+
+  // the empty index is still refused by at()
+  bool refused = false;
+  try
+  {
+    vector.at(3);
+  }
+  catch (const std::out_of_range&)
+  {
+    refused = true;
+  }
+  CHECK(refused);
+
+  vector.clear();
+  CHECK(vector.size() == 0);
+  CHECK(vector.begin() == vector.end());
+}
+
+/**
+ * @brief Solo fallimenti: il vettore resta vuoto e l'iterazione non visita nulla.
+ */
+static void testOnlyFailures()
+{
+  zkl::concurrent_vector<picky> vector;
+  for (int i = 0; i < 3; i++)
+  {
+    try
+    {
+      vector.emplace_back(-1);
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+  }
+
+  CHECK(vector.empty());
+  CHECK(vector.begin() == vector.end());
+}
+
+/**
+ * @brief Più thread aggiungono elementi, alcuni falliscono, mentre un altro li percorre.
+ */
+static void testConcurrentFailures()
+{
+  const int threads = 4;
+  const int perThread = 5000;
+  zkl::concurrent_vector<picky> vector;
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < threads; t++)
+  {
+    writers.emplace_back([&vector, t]()
+                         {
+      for (int i = 0; i < perThread; i++)
+      {
+        try
+        {
+          vector.emplace_back(i % 10 == 0 ? -1 : t * perThread + i);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+      } });
+  }
+
+  // iterating while writers append must only ever see constructed elements
+  for (int pass = 0; pass < 20; pass++)
+  {
+    for (const picky& element : vector)
+      CHECK(element.value >= 0);
+  }
+
+  for (std::thread& writer : writers)
+    writer.join();
+
+  size_t visited = 0;
+  for (const picky& element : vector)
+  {
+    CHECK(element.value % perThread % 10 != 0);
+    visited++;
+  }
+  CHECK(vector.size() == static_cast<size_t>(threads * perThread * 9 / 10));
+  CHECK(visited == vector.size());
+}
+
+int main()
+{
+  testThrowingConstructor();
+  testOnlyFailures();
+  testConcurrentFailures();
+
+  if (failures != 0)
+  {
+    std::cerr << failures << " controlli falliti\n";
+    return 1;
+  }
+
+  std::cout << "Tutti i test di concurrent_vector sono passati\n";
+  return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @brief Test di regressione di `zkl::flat_hash_map`.
+ *
+ * Ogni controllo fallito stampa la riga e il programma termina con codice 1.
+ *
+ * Compilazione:
+ *   g++ -g -fsanitize=address,undefined tests/flat_hash_map.cpp -o tests/flat_hash_map.exe
+ *
+ * Uso:
+ *   tests/flat_hash_map.exe
+ */
+#include "../zkl/zkl.hpp"
+#include <cstddef>       // Per size_t
+#include <iostream>      // Per funzioni io
+#include <random>        // Per std::mt19937
+#include <unordered_map> // Per std::unordered_map
+
+static int failures = 0;
+
+#define CHECK(condition)                                                   \
+  do                                                                       \
+  {                                                                        \
+    if (!(condition))                                                      \
+    {                                                                      \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition << "\n"; \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+/**
+ * @brief Hash costante: tutte le chiavi finiscono nello stesso gruppo e traboccano nei successivi.
+ */
+struct constant_hash
+{
+  size_t operator()(int) const noexcept
+  {
+    return 0;
+  }
+};
+
+typedef zkl::flat_hash_map<int, int, constant_hash> colliding_map;
+
+/**
+ * @brief Conta le chiavi in `[0, count)` presenti nella tabella.
+ */
+static size_t countFound(const colliding_map& map, int count)
+{
+  size_t found = 0;
+  for (int key = 0; key < count; key++)
+  {
+    if (map.contains(key))
+      found++;
+  }
+
+  return found;
+}
+
+/**
+ * @brief Una cancellazione in un gruppo pieno non deve nascondere, nella copia, le chiavi traboccate oltre.
+ */
+static void testCopyAfterEraseInFullGroup()
+{
+  colliding_map map;
+  for (int key = 0; key < 20; key++)
+    map[key] = key;
+  map.erase(3);
+
+  CHECK(map.size() == 19);
+  CHECK(countFound(map, 20) == 19);
+
+  colliding_map copy(map);
+  CHECK(copy.size() == 19);
+  CHECK(countFound(copy, 20) == 19);
+  CHECK(!copy.contains(3));
+
+  colliding_map assigned;
+  assigned[100] = 100;
+  assigned = map;
+  CHECK(assigned.size() == 19);
+  CHECK(countFound(assigned, 20) == 19);
+
+  // the copy must keep inserting correctly after inheriting the tombstone
+  copy[3] = 3;
+  copy[20] = 20;
+  CHECK(copy.size() == 21);
+  CHECK(countFound(copy, 21) == 21);
+}
+
+/**
+ * @brief Confronta una sequenza casuale di operazioni, con copie e spostamenti, contro `std::unordered_map`.
+ */
+static void testAgainstUnorderedMap()
+{
+  std::mt19937 random(12345);
+  colliding_map map;
+  std::unordered_map<int, int> reference;
+
+  for (int step = 0; step < 20000; step++)
+  {
+    int key = static_cast<int>(random() % 64);
+    switch (random() % 8)
+    {
+    case 0:
+    case 1:
+    case 2:
+      map[key] = step;
+      reference[key] = step;
+      break;
+    case 3:
+    case 4:
+      CHECK(map.erase(key) == reference.erase(key));
+      break;
+    case 5:
+    {
+      colliding_map copy(map);
+      map = copy;
+      break;
+    }
+    case 6:
+    {
+      colliding_map moved(std::move(map));
+      map = std::move(moved);
+      break;
+    }
+    default:
+      CHECK(map.contains(key) == (reference.count(key) != 0));
+      break;
+    }
+  }
+
+  CHECK(map.size() == reference.size());
+  for (const auto& element : reference)
+  {
+    auto it = map.find(element.first);
+    CHECK(it != map.end() && it->second == element.second);
+  }
+}
+
+/**
+ * @brief `it = map.erase(it)` deve compilare e funzionare anche con l'overload trasparente di `erase`.
+ */
+static void testEraseWhileIterating()
+{
+  zkl::flat_hash_map<zkl::string, int> map;
+  for (int i = 0; i < 100; i++)
+    map[zkl::to_string(i)] = i;
+
+  for (auto it = map.begin(); it != map.end();)
+  {
+    if (it->second % 3 == 0)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+
+  CHECK(map.size() == 66);
+  for (int i = 0; i < 100; i++)
+    CHECK(map.contains(zkl::to_string(i)) == (i % 3 != 0));
+
+  // the transparent overload still takes keys that are not iterators
+  CHECK(map.erase("1") == 1);
+  CHECK(!map.contains("1"));
+}
+
+int main()
+{
+  testCopyAfterEraseInFullGroup();
+  testAgainstUnorderedMap();
+  testEraseWhileIterating();
+
+  if (failures != 0)
+  {
+    std::cerr << failures << " controlli falliti\n";
+    return 1;
+  }
+
+  std::cout << "Tutti i test di flat_hash_map sono passati\n";
+  return 0;
+}
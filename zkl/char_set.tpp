@@ -0,0 +1,88 @@
+#pragma once
+
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <cstring>
+
+namespace zkl
+{
+  char_set::char_set() : _hiCount(0), _classifiable(true)
+  {
+    std::memset(_bits, 0, sizeof(_bits));
+    std::memset(_lo, 0, sizeof(_lo));
+    std::memset(_hi, 0, sizeof(_hi));
+  }
+
+  char_set::char_set(const char* chars, size_t n) : char_set()
+  {
+    for (size_t i = 0; i < n; i++)
+      insert(chars[i]);
+  }
+
+  char_set::char_set(string_view chars) : char_set(chars.data(), chars.size())
+  {
+  }
+
+  void char_set::insert(char c)
+  {
+    unsigned char x = static_cast<unsigned char>(c);
+    _bits[x >> 6] |= uint64_t(1) << (x & 63);
+
+    if (!_classifiable)
+      return;
+
+    // every distinct high nibble needs one of the 8 bits of a table byte
+    unsigned char hi = x >> 4;
+    if (_hi[hi] == 0)
+    {
+      if (_hiCount == 8)
+      {
+        _classifiable = false;
+        return;
+      }
+      _hi[hi] = static_cast<unsigned char>(1u << _hiCount++);
+    }
+
+    _lo[x & 15] |= _hi[hi];
+  }
+
+  bool char_set::contains(char c) const noexcept
+  {
+    unsigned char x = static_cast<unsigned char>(c);
+    return (_bits[x >> 6] >> (x & 63)) & 1;
+  }
+
+  size_t char_set::scan(const char* data, size_t n, bool negate) const noexcept
+  {
+    if (_classifiable)
+    {
+      const detail::class_search_kernels& kernels = detail::class_search();
+      return (negate ? kernels.find_not : kernels.find)(data, n, _lo, _hi);
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+      if (contains(data[i]) != negate)
+        return i;
+    }
+
+    return detail::not_found;
+  }
+
+  size_t char_set::rscan(const char* data, size_t n, bool negate) const noexcept
+  {
+    if (_classifiable)
+    {
+      const detail::class_search_kernels& kernels = detail::class_search();
+      return (negate ? kernels.rfind_not : kernels.rfind)(data, n, _lo, _hi);
+    }
+
+    for (size_t i = n; i-- > 0;)
+    {
+      if (contains(data[i]) != negate)
+        return i;
+    }
+
+    return detail::not_found;
+  }
+} // namespace zkl
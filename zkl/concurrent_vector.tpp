@@ -0,0 +1,410 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace zkl
+{
+  template <typename T>
+  template <bool Const>
+  concurrent_vector<T>::basic_iterator<Const>::basic_iterator() noexcept : _owner(nullptr), _index(_endIndex), _element(nullptr)
+  {
+  }
+
+  template <typename T>
+  template <bool Const>
+  concurrent_vector<T>::basic_iterator<Const>::basic_iterator(owner_pointer owner, size_t index) noexcept : _owner(owner), _index(index), _element(nullptr)
+  {
+  }
+
+  template <typename T>
+  template <bool Const>
+  template <bool OtherConst, typename>
+  concurrent_vector<T>::basic_iterator<Const>::basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+      : _owner(other._owner), _index(other._index), _element(other._element)
+  {
+  }
+
+  template <typename T>
+  template <bool Const>
+  typename concurrent_vector<T>::template basic_iterator<Const>::reference concurrent_vector<T>::basic_iterator<Const>::operator*() const noexcept
+  {
+    return *_element;
+  }
+
+  template <typename T>
+  template <bool Const>
+  typename concurrent_vector<T>::template basic_iterator<Const>::pointer concurrent_vector<T>::basic_iterator<Const>::operator->() const noexcept
+  {
+    return _element;
+  }
+
+  template <typename T>
+  template <bool Const>
+  typename concurrent_vector<T>::template basic_iterator<Const>& concurrent_vector<T>::basic_iterator<Const>::operator++() noexcept
+  {
+    _index++;
+    skip_empty();
+    return *this;
+  }
+
+  template <typename T>
+  template <bool Const>
+  typename concurrent_vector<T>::template basic_iterator<Const> concurrent_vector<T>::basic_iterator<Const>::operator++(int) noexcept
+  {
+    basic_iterator previous = *this;
+    ++*this;
+    return previous;
+  }
+
+  template <typename T>
+  template <bool Const>
+  bool concurrent_vector<T>::basic_iterator<Const>::operator==(const basic_iterator& other) const noexcept
+  {
+    return _index == other._index;
+  }
+
+  template <typename T>
+  template <bool Const>
+  bool concurrent_vector<T>::basic_iterator<Const>::operator!=(const basic_iterator& other) const noexcept
+  {
+    return _index != other._index;
+  }
+
+  template <typename T>
+  template <bool Const>
+  void concurrent_vector<T>::basic_iterator<Const>::skip_empty() noexcept
+  {
+    // the ready flag is read once here, so a slot that stops the iterator stays dereferenceable
+    for (size_t bound = _owner->reserved(); _index < bound; _index++)
+    {
+      _element = _owner->constructed(_index);
+      if (_element != nullptr)
+        return;
+    }
+
+    _index = _endIndex;
+    _element = nullptr;
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::segment_of(size_t index) noexcept
+  {
+    // segment k holds _firstSegment * 2^k elements and starts at _firstSegment * (2^k - 1)
+    unsigned long long scaled = index / _firstSegment + 1;
+    return static_cast<size_t>(63 - __builtin_clzll(scaled));
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::segment_start(size_t segment) noexcept
+  {
+    return _firstSegment * ((size_t(1) << segment) - 1);
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::segment_size(size_t segment) noexcept
+  {
+    return _firstSegment << segment;
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::segment_allocation(size_t segment) noexcept
+  {
+    // one state byte per element, stored after the elements in the same allocation
+    size_t count = segment_size(segment);
+    return count + (count + sizeof(T) - 1) / sizeof(T);
+  }
+
+  template <typename T>
+  std::atomic<uint8_t>* concurrent_vector<T>::ready_flags(T* data, size_t segment) noexcept
+  {
+    return reinterpret_cast<std::atomic<uint8_t>*>(data + segment_size(segment));
+  }
+
+  template <typename T>
+  T* concurrent_vector<T>::acquire_segment(size_t segment)
+  {
+    T* data = _segments[segment].load(std::memory_order_acquire);
+    if (data != nullptr)
+      return data;
+
+    T* fresh = std::allocator<T>().allocate(segment_allocation(segment));
+    std::atomic<uint8_t>* flags = ready_flags(fresh, segment);
+    for (size_t i = 0; i < segment_size(segment); i++)
+      ::new (static_cast<void*>(flags + i)) std::atomic<uint8_t>(0);
+
+    if (_segments[segment].compare_exchange_strong(data, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+      return fresh;
+
+    // another thread published the segment first
+    std::allocator<T>().deallocate(fresh, segment_allocation(segment));
+    return data;
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::reserved() const noexcept
+  {
+    // indices past max_size() were reserved by push_backs that threw
+    size_t size = _size.load(std::memory_order_acquire);
+    return size < max_size() ? size : max_size();
+  }
+
+  template <typename T>
+  T* concurrent_vector<T>::constructed(size_t index) const noexcept
+  {
+    if (index >= reserved())
+      return nullptr;
+
+    size_t segment = segment_of(index);
+    T* data = _segments[segment].load(std::memory_order_acquire);
+    if (data == nullptr)
+      return nullptr;
+
+    size_t offset = index - segment_start(segment);
+    if (ready_flags(data, segment)[offset].load(std::memory_order_acquire) == 0)
+      return nullptr;
+
+    return data + offset;
+  }
+
+  template <typename T>
+  template <typename... Args>
+  size_t concurrent_vector<T>::construct_next(Args&&... args)
+  {
+    size_t index = _size.fetch_add(1, std::memory_order_relaxed);
+    if (index >= max_size())
+    {
+      throw std::length_error("Vector too long");
+    }
+
+    size_t segment = segment_of(index);
+    size_t offset = index - segment_start(segment);
+    T* data;
+    try
+    {
+      data = acquire_segment(segment);
+      ::new (static_cast<void*>(data + offset)) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      // the index stays empty: size() stops counting it and iterators skip it
+      _failed.fetch_add(1, std::memory_order_relaxed);
+      throw;
+    }
+
+    // publishes the element to at() in other threads
+    ready_flags(data, segment)[offset].store(1, std::memory_order_release);
+    return index;
+  }
+
+  template <typename T>
+  concurrent_vector<T>::concurrent_vector() noexcept : _size(0), _failed(0)
+  {
+    for (size_t i = 0; i < _segmentCount; i++)
+      _segments[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  template <typename T>
+  concurrent_vector<T>::concurrent_vector(concurrent_vector&& other) noexcept
+      : _size(other._size.load(std::memory_order_relaxed)), _failed(other._failed.load(std::memory_order_relaxed))
+  {
+    for (size_t i = 0; i < _segmentCount; i++)
+    {
+      _segments[i].store(other._segments[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      other._segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+    other._size.store(0, std::memory_order_relaxed);
+    other._failed.store(0, std::memory_order_relaxed);
+  }
+
+  template <typename T>
+  concurrent_vector<T>::~concurrent_vector()
+  {
+    clear();
+
+    for (size_t i = 0; i < _segmentCount; i++)
+    {
+      T* data = _segments[i].load(std::memory_order_relaxed);
+      if (data != nullptr)
+        std::allocator<T>().deallocate(data, segment_allocation(i));
+    }
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::push_back(const T& value)
+  {
+    return construct_next(value);
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::push_back(T&& value)
+  {
+    return construct_next(std::move(value));
+  }
+
+  template <typename T>
+  template <typename... Args>
+  T& concurrent_vector<T>::emplace_back(Args&&... args)
+  {
+    return (*this)[construct_next(std::forward<Args>(args)...)];
+  }
+
+  template <typename T>
+  T& concurrent_vector<T>::at(size_t index)
+  {
+    T* element = constructed(index);
+    if (element == nullptr)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+
+    return *element;
+  }
+
+  template <typename T>
+  const T& concurrent_vector<T>::at(size_t index) const
+  {
+    T* element = constructed(index);
+    if (element == nullptr)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+
+    return *element;
+  }
+
+  template <typename T>
+  T& concurrent_vector<T>::operator[](size_t index) noexcept
+  {
+    size_t segment = segment_of(index);
+    return _segments[segment].load(std::memory_order_relaxed)[index - segment_start(segment)];
+  }
+
+  template <typename T>
+  const T& concurrent_vector<T>::operator[](size_t index) const noexcept
+  {
+    size_t segment = segment_of(index);
+    return _segments[segment].load(std::memory_order_relaxed)[index - segment_start(segment)];
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::size() const noexcept
+  {
+    // failures are counted after their index was reserved and _size only grows, so loading
+    // _failed first keeps the difference from wrapping
+    size_t failed = _failed.load(std::memory_order_acquire);
+    return reserved() - failed;
+  }
+
+  template <typename T>
+  bool concurrent_vector<T>::empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  template <typename T>
+  size_t concurrent_vector<T>::capacity() const noexcept
+  {
+    size_t capacity = 0;
+    for (size_t i = 0; i < _segmentCount; i++)
+    {
+      if (_segments[i].load(std::memory_order_acquire) != nullptr)
+        capacity += segment_size(i);
+    }
+
+    return capacity;
+  }
+
+  template <typename T>
+  constexpr size_t concurrent_vector<T>::max_size() noexcept
+  {
+    return _firstSegment * ((size_t(1) << _segmentCount) - 1);
+  }
+
+  template <typename T>
+  void concurrent_vector<T>::reserve(size_t newCapacity)
+  {
+    if (newCapacity > max_size())
+    {
+      throw std::length_error("Vector too long");
+    }
+
+    if (newCapacity == 0)
+      return;
+
+    size_t last = segment_of(newCapacity - 1);
+    for (size_t i = 0; i <= last; i++)
+      acquire_segment(i);
+  }
+
+  template <typename T>
+  void concurrent_vector<T>::clear() noexcept
+  {
+    size_t count = reserved();
+    for (size_t segment = 0; segment < _segmentCount && segment_start(segment) < count; segment++)
+    {
+      T* data = _segments[segment].load(std::memory_order_relaxed);
+      if (data == nullptr)
+        continue;
+
+      std::atomic<uint8_t>* flags = ready_flags(data, segment);
+      size_t used = count - segment_start(segment);
+      if (used > segment_size(segment))
+        used = segment_size(segment);
+
+      for (size_t i = 0; i < used; i++)
+      {
+        if (flags[i].load(std::memory_order_relaxed) != 0)
+        {
+          data[i].~T();
+          flags[i].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    _size.store(0, std::memory_order_relaxed);
+    _failed.store(0, std::memory_order_relaxed);
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::iterator concurrent_vector<T>::begin() noexcept
+  {
+    iterator it(this, 0);
+    it.skip_empty();
+    return it;
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::const_iterator concurrent_vector<T>::begin() const noexcept
+  {
+    const_iterator it(this, 0);
+    it.skip_empty();
+    return it;
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::const_iterator concurrent_vector<T>::cbegin() const noexcept
+  {
+    return begin();
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::iterator concurrent_vector<T>::end() noexcept
+  {
+    return iterator(this, _endIndex);
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::const_iterator concurrent_vector<T>::end() const noexcept
+  {
+    return const_iterator(this, _endIndex);
+  }
+
+  template <typename T>
+  typename concurrent_vector<T>::const_iterator concurrent_vector<T>::cend() const noexcept
+  {
+    return end();
+  }
+} // namespace zkl
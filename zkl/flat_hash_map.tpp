@@ -0,0 +1,627 @@
+#pragma once
+
+#include "hash.tpp"
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <new>
+#include <stdexcept>
+#include <tuple>
+
+namespace zkl
+{
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::basic_iterator() noexcept : _ctrl(nullptr), _slot(nullptr)
+  {
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::basic_iterator(const int8_t* ctrl, slot* slot) noexcept : _ctrl(ctrl), _slot(slot)
+  {
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  template <bool OtherConst, typename>
+  flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::basic_iterator(const basic_iterator<OtherConst>& other) noexcept : _ctrl(other._ctrl), _slot(other._slot)
+  {
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::template basic_iterator<Const>::reference flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator*() const noexcept
+  {
+    return value_at(*_slot);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::template basic_iterator<Const>::pointer flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator->() const noexcept
+  {
+    return &value_at(*_slot);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::template basic_iterator<Const>& flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator++() noexcept
+  {
+    ++_ctrl;
+    ++_slot;
+    skip_free();
+    return *this;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::template basic_iterator<Const> flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator++(int) noexcept
+  {
+    basic_iterator previous = *this;
+    ++*this;
+    return previous;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  template <bool OtherConst>
+  bool flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator==(const basic_iterator<OtherConst>& other) const noexcept
+  {
+    return _ctrl == other._ctrl;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  template <bool OtherConst>
+  bool flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::operator!=(const basic_iterator<OtherConst>& other) const noexcept
+  {
+    return _ctrl != other._ctrl;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <bool Const>
+  void flat_hash_map<K, V, Hash, KeyEqual>::basic_iterator<Const>::skip_free() noexcept
+  {
+    // the sentinel after the last cell stops the scan
+    while (*_ctrl < detail::ctrl_sentinel)
+    {
+      ++_ctrl;
+      ++_slot;
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>::flat_hash_map() : _size(0), _capacity(0), _growthLeft(0)
+  {
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>::flat_hash_map(const flat_hash_map& other)
+      : _size(0), _capacity(0), _growthLeft(0), _hash(other._hash), _equal(other._equal)
+  {
+    if (other._size == 0)
+      return;
+
+    _ctrl.resize(other._capacity + 1);
+    _slots.resize(other._capacity);
+    _capacity = other._capacity;
+    for (size_t i = 0; i < _capacity; i++)
+      _ctrl[i] = detail::ctrl_empty;
+    _ctrl[_capacity] = detail::ctrl_sentinel;
+    _growthLeft = other._growthLeft;
+
+    // same capacity, so every element can keep its cell and no hash is recomputed;
+    // tombstones are kept too, otherwise a group that was once full would end probes
+    // that still have to reach elements stored past it
+    try
+    {
+      for (size_t i = 0; i < _capacity; i++)
+      {
+        if (other._ctrl[i] < 0)
+        {
+          _ctrl[i] = other._ctrl[i];
+          continue;
+        }
+
+        ::new (static_cast<void*>(_slots[i].bytes)) value_type(value_at(other._slots[i]));
+        _ctrl[i] = other._ctrl[i];
+        _size++;
+      }
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>::flat_hash_map(flat_hash_map&& other) noexcept : _size(0), _capacity(0), _growthLeft(0)
+  {
+    swap(other);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>::~flat_hash_map()
+  {
+    for (size_t i = 0; i < _capacity; i++)
+    {
+      if (_ctrl[i] >= 0)
+        value_at(_slots[i]).~value_type();
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>& flat_hash_map<K, V, Hash, KeyEqual>::operator=(const flat_hash_map& other)
+  {
+    if (this != &other)
+    {
+      flat_hash_map copy(other);
+      swap(copy);
+    }
+
+    return *this;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  flat_hash_map<K, V, Hash, KeyEqual>& flat_hash_map<K, V, Hash, KeyEqual>::operator=(flat_hash_map&& other) noexcept
+  {
+    if (this != &other)
+    {
+      flat_hash_map moved(std::move(other));
+      swap(moved);
+    }
+
+    return *this;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::begin() noexcept
+  {
+    if (_size == 0)
+      return end();
+
+    iterator it = iterator_at(0);
+    it.skip_free();
+    return it;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::const_iterator flat_hash_map<K, V, Hash, KeyEqual>::begin() const noexcept
+  {
+    if (_size == 0)
+      return end();
+
+    const_iterator it = iterator_at(0);
+    it.skip_free();
+    return it;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::end() noexcept
+  {
+    return iterator_at(_capacity);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::const_iterator flat_hash_map<K, V, Hash, KeyEqual>::end() const noexcept
+  {
+    return iterator_at(_capacity);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::size() const noexcept
+  {
+    return _size;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  bool flat_hash_map<K, V, Hash, KeyEqual>::empty() const noexcept
+  {
+    return _size == 0;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::capacity() const noexcept
+  {
+    return _capacity;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  void flat_hash_map<K, V, Hash, KeyEqual>::clear() noexcept
+  {
+    for (size_t i = 0; i < _capacity; i++)
+    {
+      if (_ctrl[i] >= 0)
+        value_at(_slots[i]).~value_type();
+      _ctrl[i] = detail::ctrl_empty;
+    }
+
+    _size = 0;
+    _growthLeft = max_load(_capacity);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  void flat_hash_map<K, V, Hash, KeyEqual>::reserve(size_t count)
+  {
+    size_t newCapacity = detail::group_width;
+    while (max_load(newCapacity) < count)
+      newCapacity *= 2;
+
+    if (newCapacity > _capacity)
+      rehash(newCapacity);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  std::pair<typename flat_hash_map<K, V, Hash, KeyEqual>::iterator, bool> flat_hash_map<K, V, Hash, KeyEqual>::insert(const value_type& value)
+  {
+    size_t hash = hash_key(value.first);
+    size_t index = find_index(value.first, hash);
+    if (index != _capacity)
+      return std::pair<iterator, bool>(iterator_at(index), false);
+
+    index = prepare_insert(hash);
+    construct_at(index, value);
+    return std::pair<iterator, bool>(iterator_at(index), true);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  std::pair<typename flat_hash_map<K, V, Hash, KeyEqual>::iterator, bool> flat_hash_map<K, V, Hash, KeyEqual>::insert(value_type&& value)
+  {
+    size_t hash = hash_key(value.first);
+    size_t index = find_index(value.first, hash);
+    if (index != _capacity)
+      return std::pair<iterator, bool>(iterator_at(index), false);
+
+    index = prepare_insert(hash);
+    construct_at(index, std::move(value));
+    return std::pair<iterator, bool>(iterator_at(index), true);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename... Args>
+  std::pair<typename flat_hash_map<K, V, Hash, KeyEqual>::iterator, bool> flat_hash_map<K, V, Hash, KeyEqual>::try_emplace(const K& key, Args&&... args)
+  {
+    size_t hash = hash_key(key);
+    size_t index = find_index(key, hash);
+    if (index != _capacity)
+      return std::pair<iterator, bool>(iterator_at(index), false);
+
+    index = prepare_insert(hash);
+    construct_at(index, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    return std::pair<iterator, bool>(iterator_at(index), true);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename... Args>
+  std::pair<typename flat_hash_map<K, V, Hash, KeyEqual>::iterator, bool> flat_hash_map<K, V, Hash, KeyEqual>::try_emplace(K&& key, Args&&... args)
+  {
+    size_t hash = hash_key(key);
+    size_t index = find_index(key, hash);
+    if (index != _capacity)
+      return std::pair<iterator, bool>(iterator_at(index), false);
+
+    index = prepare_insert(hash);
+    construct_at(index, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    return std::pair<iterator, bool>(iterator_at(index), true);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  V& flat_hash_map<K, V, Hash, KeyEqual>::operator[](const K& key)
+  {
+    return try_emplace(key).first->second;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  V& flat_hash_map<K, V, Hash, KeyEqual>::operator[](K&& key)
+  {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  V& flat_hash_map<K, V, Hash, KeyEqual>::at(const K& key)
+  {
+    size_t index = find_index(key, hash_key(key));
+    if (index == _capacity)
+    {
+      throw std::out_of_range("Key not found");
+    }
+
+    return value_at(_slots[index]).second;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  const V& flat_hash_map<K, V, Hash, KeyEqual>::at(const K& key) const
+  {
+    size_t index = find_index(key, hash_key(key));
+    if (index == _capacity)
+    {
+      throw std::out_of_range("Key not found");
+    }
+
+    return value_at(_slots[index]).second;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::find(const K& key)
+  {
+    return iterator_at(find_index(key, hash_key(key)));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::const_iterator flat_hash_map<K, V, Hash, KeyEqual>::find(const K& key) const
+  {
+    return iterator_at(find_index(key, hash_key(key)));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q, typename>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::find(const Q& key)
+  {
+    return iterator_at(find_index(key, hash_key(key)));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q, typename>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::const_iterator flat_hash_map<K, V, Hash, KeyEqual>::find(const Q& key) const
+  {
+    return iterator_at(find_index(key, hash_key(key)));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  bool flat_hash_map<K, V, Hash, KeyEqual>::contains(const K& key) const
+  {
+    return find_index(key, hash_key(key)) != _capacity;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q, typename>
+  bool flat_hash_map<K, V, Hash, KeyEqual>::contains(const Q& key) const
+  {
+    return find_index(key, hash_key(key)) != _capacity;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::erase(const K& key)
+  {
+    size_t index = find_index(key, hash_key(key));
+    if (index == _capacity)
+      return 0;
+
+    erase_index(index);
+    return 1;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q, typename>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::erase(const Q& key)
+  {
+    size_t index = find_index(key, hash_key(key));
+    if (index == _capacity)
+      return 0;
+
+    erase_index(index);
+    return 1;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::erase(const_iterator pos)
+  {
+    size_t index = static_cast<size_t>(pos._slot - &_slots[0]);
+    erase_index(index);
+
+    iterator next = iterator_at(index + 1);
+    next.skip_free();
+    return next;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::erase(iterator pos)
+  {
+    return erase(const_iterator(pos));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  void flat_hash_map<K, V, Hash, KeyEqual>::swap(flat_hash_map& other) noexcept
+  {
+    _ctrl.swap(other._ctrl);
+    _slots.swap(other._slots);
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+    std::swap(_growthLeft, other._growthLeft);
+    std::swap(_hash, other._hash);
+    std::swap(_equal, other._equal);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::value_type& flat_hash_map<K, V, Hash, KeyEqual>::value_at(slot& s) noexcept
+  {
+    return *std::launder(reinterpret_cast<value_type*>(s.bytes));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  const typename flat_hash_map<K, V, Hash, KeyEqual>::value_type& flat_hash_map<K, V, Hash, KeyEqual>::value_at(const slot& s) noexcept
+  {
+    return *std::launder(reinterpret_cast<const value_type*>(s.bytes));
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::hash_key(const Q& key) const
+  {
+    size_t hash = _hash(key);
+
+    // std::hash of integers is the identity: spread it so both the group index
+    // (high bits) and the control byte (low 7 bits) vary
+    if (!detail::hash_is_avalanching<Hash>::value)
+      hash = static_cast<size_t>(detail::hash_mix(hash, 0x9E3779B97F4A7C15ull));
+
+    return hash;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename Q>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::find_index(const Q& key, size_t hash) const
+  {
+    if (_size == 0)
+      return _capacity;
+
+    const int8_t* ctrl = &_ctrl[0];
+    const int8_t tag = static_cast<int8_t>(hash & 0x7F);
+    size_t groupMask = _capacity / detail::group_width - 1;
+    size_t group = (hash >> 7) & groupMask;
+
+    // triangular probing over groups visits every group once
+    for (size_t step = 1;; step++)
+    {
+      const int8_t* groupCtrl = ctrl + group * detail::group_width;
+
+      for (unsigned match = detail::group_match(groupCtrl, tag); match != 0; match &= match - 1)
+      {
+        size_t index = group * detail::group_width + __builtin_ctz(match);
+        if (_equal(value_at(_slots[index]).first, key))
+          return index;
+      }
+
+      // a group that was never full ends every probe sequence passing through it
+      if (detail::group_match(groupCtrl, detail::ctrl_empty) != 0)
+        return _capacity;
+
+      group = (group + step) & groupMask;
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::find_free(size_t hash) const noexcept
+  {
+    const int8_t* ctrl = &_ctrl[0];
+    size_t groupMask = _capacity / detail::group_width - 1;
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1;; step++)
+    {
+      unsigned match = detail::group_match_free(ctrl + group * detail::group_width);
+      if (match != 0)
+        return group * detail::group_width + __builtin_ctz(match);
+
+      group = (group + step) & groupMask;
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::prepare_insert(size_t hash)
+  {
+    if (_growthLeft == 0)
+    {
+      // mostly tombstones: rebuild at the same size instead of growing
+      if (_capacity == 0)
+        rehash(detail::group_width);
+      else if (_size * 2 <= max_load(_capacity))
+        rehash(_capacity);
+      else
+        rehash(_capacity * 2);
+    }
+
+    size_t index = find_free(hash);
+    if (_ctrl[index] == detail::ctrl_empty)
+      _growthLeft--;
+    _ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+
+    return index;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  void flat_hash_map<K, V, Hash, KeyEqual>::rehash(size_t newCapacity)
+  {
+    vector<int8_t> oldCtrl;
+    vector<slot> oldSlots;
+    size_t oldCapacity = _capacity;
+    oldCtrl.swap(_ctrl);
+    oldSlots.swap(_slots);
+
+    _ctrl.resize(newCapacity + 1);
+    _slots.resize(newCapacity);
+    for (size_t i = 0; i < newCapacity; i++)
+      _ctrl[i] = detail::ctrl_empty;
+    _ctrl[newCapacity] = detail::ctrl_sentinel;
+    _capacity = newCapacity;
+    _growthLeft = max_load(newCapacity) - _size;
+
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+      if (oldCtrl[i] < 0)
+        continue;
+
+      value_type& value = value_at(oldSlots[i]);
+      size_t hash = hash_key(value.first);
+      size_t index = find_free(hash);
+      _ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+
+      // the old element is destroyed right after, so its key can be moved from
+      // (as std::map node handles do) instead of copied
+      ::new (static_cast<void*>(_slots[index].bytes)) value_type(std::move(const_cast<K&>(value.first)), std::move(value.second));
+      value.~value_type();
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  template <typename... Args>
+  void flat_hash_map<K, V, Hash, KeyEqual>::construct_at(size_t index, Args&&... args)
+  {
+    try
+    {
+      ::new (static_cast<void*>(_slots[index].bytes)) value_type(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      _ctrl[index] = detail::ctrl_deleted;
+      throw;
+    }
+
+    _size++;
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  void flat_hash_map<K, V, Hash, KeyEqual>::erase_index(size_t index) noexcept
+  {
+    value_at(_slots[index]).~value_type();
+    _size--;
+
+    // if the group still has an empty cell no probe ever continued past it,
+    // so the cell can become empty again instead of a tombstone
+    const int8_t* groupCtrl = &_ctrl[index & ~(detail::group_width - 1)];
+    if (detail::group_match(groupCtrl, detail::ctrl_empty) != 0)
+    {
+      _ctrl[index] = detail::ctrl_empty;
+      _growthLeft++;
+    }
+    else
+    {
+      _ctrl[index] = detail::ctrl_deleted;
+    }
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::iterator flat_hash_map<K, V, Hash, KeyEqual>::iterator_at(size_t index) noexcept
+  {
+    if (_capacity == 0)
+      return iterator();
+
+    return iterator(&_ctrl[0] + index, &_slots[0] + index);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  typename flat_hash_map<K, V, Hash, KeyEqual>::const_iterator flat_hash_map<K, V, Hash, KeyEqual>::iterator_at(size_t index) const noexcept
+  {
+    if (_capacity == 0)
+      return const_iterator();
+
+    // iterators hold a mutable cell pointer; const_iterator only hands out const references
+    return const_iterator(&_ctrl[0] + index, const_cast<slot*>(&_slots[0]) + index);
+  }
+
+  template <typename K, typename V, typename Hash, typename KeyEqual>
+  size_t flat_hash_map<K, V, Hash, KeyEqual>::max_load(size_t capacity) noexcept
+  {
+    return capacity - capacity / 8;
+  }
+} // namespace zkl
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <utility>
+
+namespace zkl
+{
+  namespace detail
+  {
+    /** Costanti del percorso per input corti, le stesse di wyhash. */
+    static const uint64_t hash_wy[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+    /**
+     * @brief Chiave del percorso per input lunghi.
+     *
+     * Il blocco di 64 byte `s` di ogni gruppo di 16 usa le parole `[s, s + 8)`, così due blocchi
+     * scambiati di posto producono un hash diverso; le parole `[16, 24)` servono al rimescolamento.
+     */
+    static const uint64_t hash_secret[24] = {
+        0xc0e16b163a85a4dcull, 0x890acd8dd443c47cull, 0xb3889d8a6dc47761ull, 0x6a0398e528f0ae6aull,
+        0x048344ece48a855eull, 0xf175cfea21871330ull, 0x391ceef02702c2fdull, 0x4baf8cac4784cb12ull,
+        0x3547744583a3f88eull, 0xd9cf2b15c6b6c90eull, 0x961facc76d5fe21cull, 0x0094ab49d50f11f9ull,
+        0xe3211e37bdbeb6dcull, 0x62fe6c274ff3511aull, 0x5ac30b329fdf0574ull, 0x1450582c6b65b406ull,
+        0x7a30fcc7888eb791ull, 0x5540f5ba6a15576eull, 0x16cef0559096d3e9ull, 0x2cf8f14b06874899ull,
+        0xc9c9263b6e2ce103ull, 0xd6ff920b0a9faa6dull, 0x53192697db998dc1ull, 0x73ea9b9bc7cd18d7ull};
+
+    /** Lunghezza oltre la quale si usa il percorso vettoriale. */
+    static const size_t hash_long_threshold = 256;
+
+    /** Blocchi di 64 byte accumulati tra due rimescolamenti. */
+    static const size_t hash_group_stripes = 16;
+
+    /**
+     * @brief Moltiplica `a` e `b` a 128 bit: `a` riceve la metà bassa, `b` quella alta.
+     */
+    inline void multiply_128(uint64_t& a, uint64_t& b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+      unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+      a = static_cast<uint64_t>(product);
+      b = static_cast<uint64_t>(product >> 64);
+#else
+      uint64_t ha = a >> 32, la = a & 0xFFFFFFFFu, hb = b >> 32, lb = b & 0xFFFFFFFFu;
+      uint64_t high = ha * hb, mid0 = ha * lb, mid1 = la * hb, low = la * lb;
+      uint64_t t = low + (mid0 << 32);
+      uint64_t carry = t < low;
+      uint64_t lo = t + (mid1 << 32);
+      carry += lo < t;
+      a = lo;
+      b = high + (mid0 >> 32) + (mid1 >> 32) + carry;
+#endif
+    }
+
+    inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept
+    {
+      multiply_128(a, b);
+      return a ^ b;
+    }
+
+    inline uint64_t read_u32(const char* p) noexcept
+    {
+      uint32_t value;
+      std::memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    /**
+     * @brief Hash per input fino a `hash_long_threshold` byte (wyhash).
+     */
+    uint64_t hash_short(const char* p, size_t n, uint64_t seed) noexcept
+    {
+      const uint64_t* s = hash_wy;
+      seed ^= hash_mix(seed ^ s[0], s[1]);
+
+      uint64_t a, b;
+      if (n <= 16)
+      {
+        if (n >= 4)
+        {
+          // two possibly overlapping 4-byte reads from each end cover 4..16 bytes
+          size_t shift = (n >> 3) << 2;
+          a = (read_u32(p) << 32) | read_u32(p + shift);
+          b = (read_u32(p + n - 4) << 32) | read_u32(p + n - 4 - shift);
+        }
+        else if (n > 0)
+        {
+          const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+          a = (uint64_t(u[0]) << 16) | (uint64_t(u[n >> 1]) << 8) | u[n - 1];
+          b = 0;
+        }
+        else
+        {
+          a = b = 0;
+        }
+      }
+      else
+      {
+        size_t i = n;
+        if (i > 48)
+        {
+          uint64_t see1 = seed, see2 = seed;
+          do
+          {
+            seed = hash_mix(read_u64(p) ^ s[1], read_u64(p + 8) ^ seed);
+            see1 = hash_mix(read_u64(p + 16) ^ s[2], read_u64(p + 24) ^ see1);
+            see2 = hash_mix(read_u64(p + 32) ^ s[3], read_u64(p + 40) ^ see2);
+            p += 48;
+            i -= 48;
+          } while (i > 48);
+          seed ^= see1 ^ see2;
+        }
+
+        while (i > 16)
+        {
+          seed = hash_mix(read_u64(p) ^ s[1], read_u64(p + 8) ^ seed);
+          p += 16;
+          i -= 16;
+        }
+
+        // the last 16 bytes of the input, overlapping what was already consumed
+        a = read_u64(p + i - 16);
+        b = read_u64(p + i - 8);
+      }
+
+      a ^= s[1];
+      b ^= seed;
+      multiply_128(a, b);
+      return hash_mix(a ^ s[0] ^ n, b ^ s[1]);
+    }
+
+    /**
+     * @brief Rimescola gli accumulatori tra un gruppo di blocchi e il successivo.
+     */
+    inline void hash_scramble(uint64_t* acc) noexcept
+    {
+      for (size_t i = 0; i < 8; i++)
+      {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= hash_secret[16 + i];
+        acc[i] = a * 0x9E3779B1u;
+      }
+    }
+
+    /**
+     * @brief Hash per input più lunghi di `hash_long_threshold` byte.
+     *
+     * Accumula blocchi di 64 byte in 8 corsie con il kernel SIMD selezionato, rimescola ogni 16
+     * blocchi e infine riduce le corsie a 64 bit.
+     */
+    uint64_t hash_long(const char* p, size_t n, uint64_t seed) noexcept
+    {
+      uint64_t acc[8] = {0x000000009E3779B1ull, 0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full,
+                         0x165667B19E3779F9ull, 0x85EBCA77C2B2AE63ull, 0x0000000085EBCA77ull,
+                         0x27D4EB2F165667C5ull, 0x00000000C2B2AE3Dull};
+      for (size_t i = 0; i < 8; i++)
+        acc[i] ^= seed;
+
+      hash_accumulate_fn accumulate = hash_accumulate();
+      const size_t groupBytes = hash_group_stripes * 64;
+
+      // the last stripe always holds data and is handled separately below
+      size_t groups = (n - 1) / groupBytes;
+      for (size_t g = 0; g < groups; g++)
+      {
+        accumulate(acc, p + g * groupBytes, hash_group_stripes, hash_secret);
+        hash_scramble(acc);
+      }
+
+      size_t stripes = (n - 1 - groups * groupBytes) / 64;
+      accumulate(acc, p + groups * groupBytes, stripes, hash_secret);
+      accumulate(acc, p + n - 64, 1, hash_secret + 7);
+
+      uint64_t result = n * 0x9E3779B185EBCA87ull ^ seed;
+      for (size_t i = 0; i < 4; i++)
+        result += hash_mix(acc[2 * i] ^ hash_secret[2 * i + 1], acc[2 * i + 1] ^ hash_secret[2 * i + 2]);
+
+      result ^= result >> 37;
+      result *= 0x165667919E3779F9ull;
+      result ^= result >> 32;
+      return result;
+    }
+  } // namespace detail
+
+  uint64_t hash_bytes(const void* data, size_t n, uint64_t seed) noexcept
+  {
+    const char* p = static_cast<const char*>(data);
+    if (n <= detail::hash_long_threshold)
+      return detail::hash_short(p, n, seed);
+    return detail::hash_long(p, n, seed);
+  }
+
+  size_t hash::operator()(string_view str) const noexcept
+  {
+    return static_cast<size_t>(hash_bytes(str.data(), str.size()));
+  }
+
+  size_t hash::operator()(const hashed_string& str) const noexcept
+  {
+    return str.hash();
+  }
+
+  hashed_string::hashed_string() noexcept : _str(), _hash(0)
+  {
+  }
+
+  hashed_string::hashed_string(string_view str) : _str(str), _hash(0)
+  {
+  }
+
+  hashed_string::hashed_string(string&& str) noexcept : _str(std::move(str)), _hash(0)
+  {
+  }
+
+  hashed_string::hashed_string(const hashed_string& other) : _str(other._str), _hash(other._hash.load(std::memory_order_relaxed))
+  {
+  }
+
+  hashed_string::hashed_string(hashed_string&& other) noexcept : _str(std::move(other._str)), _hash(other._hash.load(std::memory_order_relaxed))
+  {
+    other._hash.store(0, std::memory_order_relaxed);
+  }
+
+  hashed_string& hashed_string::operator=(const hashed_string& other)
+  {
+    if (this != &other)
+    {
+      _str = other._str;
+      _hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    return *this;
+  }
+
+  hashed_string& hashed_string::operator=(hashed_string&& other) noexcept
+  {
+    if (this != &other)
+    {
+      _str = std::move(other._str);
+      _hash.store(other._hash.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    return *this;
+  }
+
+  hashed_string& hashed_string::operator=(string_view str)
+  {
+    _str.assign(str);
+    _hash.store(0, std::memory_order_relaxed);
+    return *this;
+  }
+
+  size_t hashed_string::hash() const noexcept
+  {
+    // racing threads compute and store the same value, so relaxed ordering is enough;
+    // a genuine hash of 0 is simply recomputed every time
+    size_t h = _hash.load(std::memory_order_relaxed);
+    if (h == 0)
+    {
+      h = zkl::hash()(string_view(_str));
+      _hash.store(h, std::memory_order_relaxed);
+    }
+
+    return h;
+  }
+
+  size_t hashed_string::size() const noexcept
+  {
+    return _str.size();
+  }
+
+  bool hashed_string::empty() const noexcept
+  {
+    return _str.empty();
+  }
+
+  const char* hashed_string::c_str() const noexcept
+  {
+    return _str.c_str();
+  }
+
+  const string& hashed_string::str() const noexcept
+  {
+    return _str;
+  }
+
+  hashed_string::operator string_view() const noexcept
+  {
+    return string_view(_str);
+  }
+
+  bool operator==(const hashed_string& lhs, const hashed_string& rhs) noexcept
+  {
+    size_t lhsHash = lhs._hash.load(std::memory_order_relaxed);
+    size_t rhsHash = rhs._hash.load(std::memory_order_relaxed);
+    if (lhsHash != 0 && rhsHash != 0 && lhsHash != rhsHash)
+      return false;
+
+    return string_view(lhs._str) == string_view(rhs._str);
+  }
+
+  bool operator!=(const hashed_string& lhs, const hashed_string& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+} // namespace zkl
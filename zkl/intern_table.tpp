@@ -0,0 +1,261 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+namespace zkl
+{
+  /**
+   * @brief Blocco dell'arena, seguito in memoria dai caratteri delle stringhe.
+   */
+  struct intern_table::chunk
+  {
+    chunk* next;     /**< Blocco allocato in precedenza. */
+    size_t used;     /**< Byte già occupati. */
+    size_t capacity; /**< Byte disponibili dopo l'intestazione. */
+
+    char* chars()
+    {
+      return reinterpret_cast<char*>(this + 1);
+    }
+  };
+
+  intern_table::handle::handle() noexcept : _id(0)
+  {
+  }
+
+  intern_table::handle::handle(uint32_t id) noexcept : _id(id)
+  {
+  }
+
+  bool intern_table::handle::valid() const noexcept
+  {
+    return _id != 0;
+  }
+
+  uint32_t intern_table::handle::id() const noexcept
+  {
+    return _id;
+  }
+
+  size_t intern_table::handle::hash() const noexcept
+  {
+    return _id;
+  }
+
+  bool operator==(intern_table::handle lhs, intern_table::handle rhs) noexcept
+  {
+    return lhs._id == rhs._id;
+  }
+
+  bool operator!=(intern_table::handle lhs, intern_table::handle rhs) noexcept
+  {
+    return lhs._id != rhs._id;
+  }
+
+  bool operator<(intern_table::handle lhs, intern_table::handle rhs) noexcept
+  {
+    return lhs._id < rhs._id;
+  }
+
+  intern_table::intern_table() : _size(0), _slotCount(64), _chunks(nullptr), _arenaBytes(0)
+  {
+    for (size_t i = 0; i < _segmentCount; i++)
+      _entries[i] = nullptr;
+
+    _slots = new slot[_slotCount]();
+  }
+
+  intern_table::~intern_table()
+  {
+    for (size_t i = 0; i < _segmentCount; i++)
+      delete[] _entries[i];
+
+    delete[] _slots;
+
+    while (_chunks != nullptr)
+    {
+      chunk* next = _chunks->next;
+      ::operator delete(_chunks);
+      _chunks = next;
+    }
+  }
+
+  uint32_t intern_table::hash_of(string_view str) noexcept
+  {
+    uint64_t hash = hash_bytes(str.data(), str.size());
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+  }
+
+  intern_table::entry& intern_table::entry_at(size_t index) const noexcept
+  {
+    // segment k holds _firstSegment * 2^k entries and starts at _firstSegment * (2^k - 1)
+    size_t scaled = index / _firstSegment + 1;
+    size_t segment = 0;
+    while (scaled >> (segment + 1))
+      segment++;
+
+    size_t offset = index - _firstSegment * ((size_t(1) << segment) - 1);
+    return _entries[segment][offset];
+  }
+
+  uint32_t intern_table::find_id(string_view str, uint32_t hash) const noexcept
+  {
+    size_t mask = _slotCount - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+      const slot& s = _slots[i];
+      if (s.id == 0)
+        return 0;
+
+      if (s.hash == hash)
+      {
+        const entry& e = entry_at(s.id - 1);
+        if (e.size == str.size() && std::memcmp(e.data, str.data(), e.size) == 0)
+          return s.id;
+      }
+    }
+  }
+
+  const char* intern_table::store(string_view str)
+  {
+    size_t needed = str.size() + 1;
+
+    if (_chunks == nullptr || _chunks->capacity - _chunks->used < needed)
+    {
+      size_t capacity = needed > _chunkSize ? needed : _chunkSize;
+      chunk* c = new (::operator new(sizeof(chunk) + capacity)) chunk;
+      c->used = 0;
+      c->capacity = capacity;
+
+      // an oversized string gets its own chunk behind the current one, so the
+      // free space left in the current chunk is not wasted
+      if (_chunks != nullptr && capacity > _chunkSize)
+      {
+        c->next = _chunks->next;
+        _chunks->next = c;
+      }
+      else
+      {
+        c->next = _chunks;
+        _chunks = c;
+      }
+
+      _arenaBytes += capacity;
+
+      char* dest = c->chars() + c->used;
+      std::memcpy(dest, str.data(), str.size());
+      dest[str.size()] = 0;
+      c->used += needed;
+      return dest;
+    }
+
+    char* dest = _chunks->chars() + _chunks->used;
+    std::memcpy(dest, str.data(), str.size());
+    dest[str.size()] = 0;
+    _chunks->used += needed;
+    return dest;
+  }
+
+  void intern_table::rehash(size_t newSlotCount)
+  {
+    slot* newSlots = new slot[newSlotCount]();
+    size_t mask = newSlotCount - 1;
+
+    for (size_t i = 0; i < _slotCount; i++)
+    {
+      if (_slots[i].id == 0)
+        continue;
+
+      size_t j = _slots[i].hash & mask;
+      while (newSlots[j].id != 0)
+        j = (j + 1) & mask;
+      newSlots[j] = _slots[i];
+    }
+
+    delete[] _slots;
+    _slots = newSlots;
+    _slotCount = newSlotCount;
+  }
+
+  intern_table::handle intern_table::intern(string_view str)
+  {
+    uint32_t hash = hash_of(str);
+
+    // most lookups hit strings that are already interned
+    {
+      std::shared_lock<std::shared_mutex> lock(_mutex);
+      uint32_t id = find_id(str, hash);
+      if (id != 0)
+        return handle(id);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+
+    // another thread may have inserted it in the meantime
+    uint32_t id = find_id(str, hash);
+    if (id != 0)
+      return handle(id);
+
+    // the segments hold _firstSegment * (2^_segmentCount - 1) entries, just under 2^32 ids
+    if (_size >= _firstSegment * ((size_t(1) << _segmentCount) - 1))
+    {
+      throw std::length_error("Intern table is full");
+    }
+
+    // keep the load factor at or below 1/2
+    if ((_size + 1) * 2 > _slotCount)
+      rehash(_slotCount * 2);
+
+    size_t index = _size;
+    size_t scaled = index / _firstSegment + 1;
+    size_t segment = 0;
+    while (scaled >> (segment + 1))
+      segment++;
+    if (_entries[segment] == nullptr)
+      _entries[segment] = new entry[_firstSegment << segment];
+
+    entry& e = entry_at(index);
+    e.data = store(str);
+    e.size = str.size();
+
+    id = static_cast<uint32_t>(index + 1);
+    size_t mask = _slotCount - 1;
+    size_t i = hash & mask;
+    while (_slots[i].id != 0)
+      i = (i + 1) & mask;
+    _slots[i].id = id;
+    _slots[i].hash = hash;
+
+    _size++;
+    return handle(id);
+  }
+
+  intern_table::handle intern_table::lookup(string_view str) const
+  {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return handle(find_id(str, hash_of(str)));
+  }
+
+  string_view intern_table::view(handle h) const noexcept
+  {
+    const entry& e = entry_at(h._id - 1);
+    return string_view(e.data, e.size);
+  }
+
+  size_t intern_table::size() const
+  {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _size;
+  }
+
+  size_t intern_table::arena_bytes() const
+  {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    return _arenaBytes;
+  }
+} // namespace zkl
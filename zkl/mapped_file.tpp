@@ -0,0 +1,219 @@
+#pragma once
+
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+
+namespace zkl
+{
+  mapped_file::line_iterator::line_iterator() noexcept : _line(), _next(nullptr), _end(nullptr), _delim('\n')
+  {
+  }
+
+  mapped_file::line_iterator::line_iterator(const char* begin, const char* end, char delim) noexcept
+      : _line(), _next(begin), _end(end), _delim(delim)
+  {
+    advance();
+  }
+
+  void mapped_file::line_iterator::advance() noexcept
+  {
+    // a delimiter right before the end closes the last record instead of opening an empty one
+    if (_next == nullptr || _next == _end)
+    {
+      _line = string_view();
+      _next = nullptr;
+      return;
+    }
+
+    size_t remaining = static_cast<size_t>(_end - _next);
+    size_t length = detail::char_search().find(_next, remaining, _delim);
+
+    if (length == detail::not_found)
+    {
+      _line = string_view(_next, remaining);
+      _next = _end;
+    }
+    else
+    {
+      _line = string_view(_next, length);
+      _next += length + 1;
+    }
+  }
+
+  const string_view& mapped_file::line_iterator::operator*() const noexcept
+  {
+    return _line;
+  }
+
+  const string_view* mapped_file::line_iterator::operator->() const noexcept
+  {
+    return &_line;
+  }
+
+  mapped_file::line_iterator& mapped_file::line_iterator::operator++() noexcept
+  {
+    advance();
+    return *this;
+  }
+
+  mapped_file::line_iterator mapped_file::line_iterator::operator++(int) noexcept
+  {
+    line_iterator previous = *this;
+    advance();
+    return previous;
+  }
+
+  bool mapped_file::line_iterator::operator==(const line_iterator& other) const noexcept
+  {
+    // every end iterator compares equal, whatever range it came from
+    if (_next == nullptr || other._next == nullptr)
+      return _next == other._next;
+    return _line.data() == other._line.data();
+  }
+
+  bool mapped_file::line_iterator::operator!=(const line_iterator& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+  mapped_file::line_range::line_range(const char* begin, const char* end, char delim) noexcept : _begin(begin), _end(end), _delim(delim)
+  {
+  }
+
+  mapped_file::line_iterator mapped_file::line_range::begin() const noexcept
+  {
+    return line_iterator(_begin, _end, _delim);
+  }
+
+  mapped_file::line_iterator mapped_file::line_range::end() const noexcept
+  {
+    return line_iterator();
+  }
+
+  mapped_file::mapped_file() noexcept : _data(nullptr), _size(0), _open(false)
+  {
+  }
+
+  mapped_file::mapped_file(const char* path) : _data(nullptr), _size(0), _open(false)
+  {
+    open(path);
+  }
+
+  mapped_file::mapped_file(const string& path) : _data(nullptr), _size(0), _open(false)
+  {
+    open(path.c_str());
+  }
+
+  mapped_file::mapped_file(mapped_file&& other) noexcept : _data(other._data), _size(other._size), _open(other._open)
+  {
+    other._data = nullptr;
+    other._size = 0;
+    other._open = false;
+  }
+
+  mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      _data = other._data;
+      _size = other._size;
+      _open = other._open;
+      other._data = nullptr;
+      other._size = 0;
+      other._open = false;
+    }
+
+    return *this;
+  }
+
+  mapped_file::~mapped_file()
+  {
+    close();
+  }
+
+  void mapped_file::open(const char* path)
+  {
+    // stdio instead of <unistd.h>, whose global names (pause, sleep, ...) clash with user code
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr)
+    {
+      throw std::system_error(errno, std::generic_category(), "mapped_file: cannot open file");
+    }
+
+    struct stat info;
+    if (::fstat(fileno(file), &info) != 0)
+    {
+      int error = errno;
+      std::fclose(file);
+      throw std::system_error(error, std::generic_category(), "mapped_file: cannot stat file");
+    }
+
+    // mmap rejects a zero length, and an empty file needs no mapping anyway
+    if (info.st_size > 0)
+    {
+      void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fileno(file), 0);
+      if (mapping == MAP_FAILED)
+      {
+        int error = errno;
+        std::fclose(file);
+        throw std::system_error(error, std::generic_category(), "mapped_file: cannot map file");
+      }
+
+      // only a hint: readahead grows and pages behind the reader can be dropped early
+      ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+      _data = static_cast<const char*>(mapping);
+      _size = static_cast<size_t>(info.st_size);
+    }
+
+    // the mapping keeps its own reference to the file
+    std::fclose(file);
+    _open = true;
+  }
+
+  void mapped_file::close() noexcept
+  {
+    if (_data != nullptr)
+      ::munmap(const_cast<char*>(_data), _size);
+
+    _data = nullptr;
+    _size = 0;
+    _open = false;
+  }
+
+  bool mapped_file::is_open() const noexcept
+  {
+    return _open;
+  }
+
+  const char* mapped_file::data() const noexcept
+  {
+    return _data;
+  }
+
+  size_t mapped_file::size() const noexcept
+  {
+    return _size;
+  }
+
+  bool mapped_file::empty() const noexcept
+  {
+    return _size == 0;
+  }
+
+  string_view mapped_file::view() const noexcept
+  {
+    return string_view(_data, _size);
+  }
+
+  mapped_file::line_range mapped_file::lines(char delim) const noexcept
+  {
+    return line_range(_data, _data + _size, delim);
+  }
+} // namespace zkl
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <cstdint>
+#include <new>
+
+namespace zkl
+{
+  /**
+   * @brief Intestazione di un blocco dell'arena, all'inizio della memoria ottenuta da `upstream`.
+   */
+  struct monotonic_arena::chunk
+  {
+    chunk* next;      /**< Blocco ottenuto in precedenza. */
+    size_t size;      /**< Byte allocati a `upstream`, intestazione compresa. */
+    size_t alignment; /**< Allineamento richiesto a `upstream`. */
+  };
+
+  monotonic_arena::monotonic_arena(size_t initialChunkSize, std::pmr::memory_resource* upstream)
+      : _current(nullptr), _end(nullptr), _chunks(nullptr), _nextChunkSize(initialChunkSize), _initialChunkSize(initialChunkSize),
+        _allocated(0), _buffer(nullptr), _bufferSize(0), _upstream(upstream)
+  {
+  }
+
+  monotonic_arena::monotonic_arena(void* buffer, size_t size, std::pmr::memory_resource* upstream)
+      : _current(static_cast<char*>(buffer)), _end(static_cast<char*>(buffer) + size), _chunks(nullptr), _nextChunkSize(size * 2),
+        _initialChunkSize(size * 2), _allocated(0), _buffer(buffer), _bufferSize(size), _upstream(upstream)
+  {
+  }
+
+  monotonic_arena::~monotonic_arena()
+  {
+    release();
+  }
+
+  void monotonic_arena::release() noexcept
+  {
+    while (_chunks != nullptr)
+    {
+      chunk* next = _chunks->next;
+      _upstream->deallocate(_chunks, _chunks->size, _chunks->alignment);
+      _chunks = next;
+    }
+
+    _current = static_cast<char*>(_buffer);
+    _end = static_cast<char*>(_buffer) + _bufferSize;
+    _nextChunkSize = _initialChunkSize;
+    _allocated = 0;
+  }
+
+  size_t monotonic_arena::bytes_allocated() const noexcept
+  {
+    return _allocated;
+  }
+
+  void* monotonic_arena::do_allocate(size_t bytes, size_t alignment)
+  {
+    uintptr_t current = reinterpret_cast<uintptr_t>(_current);
+    uintptr_t aligned = (current + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+
+    if (_current != nullptr && aligned >= current && bytes <= static_cast<size_t>(reinterpret_cast<uintptr_t>(_end) - current) &&
+        aligned - current <= static_cast<size_t>(reinterpret_cast<uintptr_t>(_end) - current) - bytes)
+    {
+      _current = reinterpret_cast<char*>(aligned + bytes);
+      _allocated += bytes;
+      return reinterpret_cast<void*>(aligned);
+    }
+
+    return allocate_from_new_chunk(bytes, alignment);
+  }
+
+  void monotonic_arena::do_deallocate(void*, size_t, size_t)
+  {
+    // memory is only reclaimed by release()
+  }
+
+  bool monotonic_arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+
+  void* monotonic_arena::allocate_from_new_chunk(size_t bytes, size_t alignment)
+  {
+    size_t chunkAlignment = alignment > alignof(chunk) ? alignment : alignof(chunk);
+
+    // room for the header, the worst-case padding after it and the request itself
+    size_t needed = sizeof(chunk) + chunkAlignment + bytes;
+    if (needed < bytes)
+    {
+      throw std::bad_alloc();
+    }
+
+    size_t size = _nextChunkSize > needed ? _nextChunkSize : needed;
+    chunk* c = static_cast<chunk*>(_upstream->allocate(size, chunkAlignment));
+    c->next = _chunks;
+    c->size = size;
+    c->alignment = chunkAlignment;
+    _chunks = c;
+
+    _current = reinterpret_cast<char*>(c + 1);
+    _end = reinterpret_cast<char*>(c) + size;
+    _nextChunkSize = size * 2;
+
+    return do_allocate(bytes, alignment);
+  }
+
+  namespace detail
+  {
+    /** Blocco libero di una classe: il puntatore al successivo occupa i suoi primi byte. */
+    struct pool::free_block
+    {
+      free_block* next;
+    };
+
+    /** Intestazione dei blocchi ottenuti da `upstream`, allineata a `alignof(std::max_align_t)`. */
+    struct alignas(std::max_align_t) pool::chunk
+    {
+      chunk* next;
+      size_t size;
+    };
+
+    pool::pool(std::pmr::memory_resource* upstream) : _chunks(nullptr), _upstream(upstream)
+    {
+      for (size_t i = 0; i < _classCount; i++)
+        _free[i] = nullptr;
+    }
+
+    pool::~pool()
+    {
+      while (_chunks != nullptr)
+      {
+        chunk* next = _chunks->next;
+        _upstream->deallocate(_chunks, _chunks->size, alignof(chunk));
+        _chunks = next;
+      }
+    }
+
+    size_t pool::class_of(size_t bytes, size_t alignment) noexcept
+    {
+      if (alignment > alignof(std::max_align_t))
+        return _classCount;
+
+      size_t sizeClass = 0;
+      size_t blockSize = _minBlock;
+      while (blockSize < bytes && sizeClass < _classCount)
+      {
+        blockSize *= 2;
+        sizeClass++;
+      }
+
+      return sizeClass;
+    }
+
+    void* pool::allocate(size_t bytes, size_t alignment)
+    {
+      size_t sizeClass = class_of(bytes, alignment);
+      if (sizeClass == _classCount)
+        return _upstream->allocate(bytes, alignment);
+
+      if (_free[sizeClass] == nullptr)
+        refill(sizeClass);
+
+      free_block* block = _free[sizeClass];
+      _free[sizeClass] = block->next;
+      return block;
+    }
+
+    void pool::deallocate(void* p, size_t bytes, size_t alignment) noexcept
+    {
+      size_t sizeClass = class_of(bytes, alignment);
+      if (sizeClass == _classCount)
+      {
+        _upstream->deallocate(p, bytes, alignment);
+        return;
+      }
+
+      free_block* block = static_cast<free_block*>(p);
+      block->next = _free[sizeClass];
+      _free[sizeClass] = block;
+    }
+
+    void pool::refill(size_t sizeClass)
+    {
+      size_t blockSize = _minBlock << sizeClass;
+      size_t blocks = _chunkSize / blockSize < 4 ? 4 : _chunkSize / blockSize;
+      size_t size = sizeof(chunk) + blocks * blockSize;
+
+      chunk* c = static_cast<chunk*>(_upstream->allocate(size, alignof(chunk)));
+      c->next = _chunks;
+      c->size = size;
+      _chunks = c;
+
+      // blocks follow the header, so every block is aligned to alignof(std::max_align_t)
+      char* first = reinterpret_cast<char*>(c + 1);
+      for (size_t i = blocks; i-- > 0;)
+      {
+        free_block* block = reinterpret_cast<free_block*>(first + i * blockSize);
+        block->next = _free[sizeClass];
+        _free[sizeClass] = block;
+      }
+    }
+  } // namespace detail
+
+  template <typename T>
+  pool_allocator<T>::pool_allocator() : _pool(std::make_shared<detail::pool>(std::pmr::new_delete_resource()))
+  {
+  }
+
+  template <typename T>
+  pool_allocator<T>::pool_allocator(std::pmr::memory_resource* upstream) : _pool(std::make_shared<detail::pool>(upstream))
+  {
+  }
+
+  template <typename T>
+  template <typename U>
+  pool_allocator<T>::pool_allocator(const pool_allocator<U>& other) noexcept : _pool(other._pool)
+  {
+  }
+
+  template <typename T>
+  T* pool_allocator<T>::allocate(size_t n)
+  {
+    if (n > static_cast<size_t>(-1) / sizeof(T))
+    {
+      throw std::bad_array_new_length();
+    }
+
+    return static_cast<T*>(_pool->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  template <typename T>
+  void pool_allocator<T>::deallocate(T* p, size_t n) noexcept
+  {
+    _pool->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  template <typename T>
+  template <typename U>
+  bool pool_allocator<T>::operator==(const pool_allocator<U>& other) const noexcept
+  {
+    return _pool == other._pool;
+  }
+
+  template <typename T>
+  template <typename U>
+  bool pool_allocator<T>::operator!=(const pool_allocator<U>& other) const noexcept
+  {
+    return _pool != other._pool;
+  }
+} // namespace zkl
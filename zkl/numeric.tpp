@@ -0,0 +1,189 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace zkl
+{
+  namespace detail
+  {
+    /** Le coppie di cifre da "00" a "99", per scrivere due cifre con una sola divisione. */
+    static const char digit_pairs[201] = "00010203040506070809"
+                                         "10111213141516171819"
+                                         "20212223242526272829"
+                                         "30313233343536373839"
+                                         "40414243444546474849"
+                                         "50515253545556575859"
+                                         "60616263646566676869"
+                                         "70717273747576777879"
+                                         "80818283848586878889"
+                                         "90919293949596979899";
+
+    /**
+     * @brief Conta le cifre decimali di un valore (almeno 1).
+     */
+    size_t count_digits(unsigned long long value)
+    {
+      size_t digits = 1;
+      for (;;)
+      {
+        // four comparisons per division keep the common short values division-free
+        if (value < 10)
+          return digits;
+        if (value < 100)
+          return digits + 1;
+        if (value < 1000)
+          return digits + 2;
+        if (value < 10000)
+          return digits + 3;
+        value /= 10000;
+        digits += 4;
+      }
+    }
+
+    /**
+     * @brief Scrive le cifre di `value` in modo che l'ultima finisca subito prima di `end`.
+     */
+    void write_digits(char* end, unsigned long long value)
+    {
+      while (value >= 100)
+      {
+        size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        std::memcpy(end, digit_pairs + pair, 2);
+      }
+
+      if (value >= 10)
+        std::memcpy(end - 2, digit_pairs + value * 2, 2);
+      else
+        end[-1] = static_cast<char>('0' + value);
+    }
+
+    /**
+     * @brief Restituisce il valore di una cifra in base fino a 36, o 36 se il carattere non è una cifra.
+     */
+    unsigned digit_value(char c)
+    {
+      if (c >= '0' && c <= '9')
+        return static_cast<unsigned>(c - '0');
+      if (c >= 'a' && c <= 'z')
+        return static_cast<unsigned>(c - 'a' + 10);
+      if (c >= 'A' && c <= 'Z')
+        return static_cast<unsigned>(c - 'A' + 10);
+      return 36;
+    }
+
+    string& append_integer(string& str, unsigned long long magnitude, bool negative)
+    {
+      size_t length = count_digits(magnitude) + (negative ? 1 : 0);
+      str.grow(str._size + length);
+
+      char* out = str._data + str._size;
+      if (negative)
+        out[0] = '-';
+      write_digits(out + length, magnitude);
+
+      str._size += length;
+      str._data[str._size] = 0;
+      return str;
+    }
+  } // namespace detail
+
+  template <typename T, detail::enable_if_integer<T>>
+  string& append_number(string& str, T value)
+  {
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+
+    // negate in unsigned arithmetic, so the most negative value does not overflow
+    bool negative = false;
+    if constexpr (std::is_signed<T>::value)
+      negative = value < 0;
+    unsigned_type magnitude = negative ? static_cast<unsigned_type>(0 - static_cast<unsigned_type>(value)) : static_cast<unsigned_type>(value);
+
+    return detail::append_integer(str, magnitude, negative);
+  }
+
+  template <typename T, detail::enable_if_floating<T>>
+  string& append_number(string& str, T value)
+  {
+    // the shortest round-trip form of a long double is under 50 characters
+    char buffer[64];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return str.append(buffer, static_cast<size_t>(result.ptr - buffer));
+  }
+
+  template <typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type>
+  string to_string(T value)
+  {
+    string str;
+    append_number(str, value);
+    return str;
+  }
+
+  template <typename T, detail::enable_if_integer<T>>
+  from_chars_result from_chars(const char* first, const char* last, T& value, int base) noexcept
+  {
+    if (base < 2 || base > 36)
+      return {first, std::errc::invalid_argument};
+
+    const char* p = first;
+    bool negative = false;
+    if constexpr (std::is_signed<T>::value)
+    {
+      if (p != last && *p == '-')
+      {
+        negative = true;
+        p++;
+      }
+    }
+
+    const unsigned long long radix = static_cast<unsigned long long>(base);
+    const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    const char* digits = p;
+    unsigned long long result = 0;
+    bool overflow = false;
+
+    for (; p != last; p++)
+    {
+      unsigned digit = detail::digit_value(*p);
+      if (digit >= radix)
+        break;
+
+      // keep consuming digits after an overflow, so ptr still lands past the whole number
+      if (result > (limit - digit) / radix)
+        overflow = true;
+      else
+        result = result * radix + digit;
+    }
+
+    if (p == digits)
+      return {first, std::errc::invalid_argument};
+    if (overflow)
+      return {p, std::errc::result_out_of_range};
+
+    value = negative ? static_cast<T>(0 - result) : static_cast<T>(result);
+    return {p, std::errc()};
+  }
+
+  template <typename T, detail::enable_if_floating<T>>
+  from_chars_result from_chars(const char* first, const char* last, T& value)
+  {
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return {result.ptr, result.ec};
+  }
+
+  template <typename T, detail::enable_if_integer<T>>
+  from_chars_result from_chars(string_view text, T& value, int base) noexcept
+  {
+    return from_chars(text.data(), text.data() + text.size(), value, base);
+  }
+
+  template <typename T, detail::enable_if_floating<T>>
+  from_chars_result from_chars(string_view text, T& value)
+  {
+    return from_chars(text.data(), text.data() + text.size(), value);
+  }
+} // namespace zkl
@@ -0,0 +1,517 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <stdexcept>
+
+namespace zkl
+{
+  namespace detail
+  {
+    /**
+     * @brief Il pool e la coda del worker che esegue il thread corrente.
+     */
+    struct worker_identity
+    {
+      const parallel::thread_pool* pool; /**< Il pool del worker, o `nullptr` per i thread esterni. */
+      size_t index;                      /**< Indice della coda del worker nel pool. */
+    };
+
+    inline worker_identity& current_worker() noexcept
+    {
+      static thread_local worker_identity identity = {nullptr, 0};
+      return identity;
+    }
+
+    /** Pezzo minimo in cui vengono divisi gli intervalli: sotto questa soglia un task costa più del lavoro. */
+    const size_t parallel_min_grain = 2048;
+
+    /**
+     * @brief Sceglie la dimensione dei pezzi per `count` elementi su `pool`.
+     */
+    inline size_t parallel_grain(size_t count, const parallel::thread_pool& pool) noexcept
+    {
+      // about 8 pieces per thread leave room for stealing to even out the load
+      size_t grain = count / ((pool.size() + 1) * 8);
+      return grain < parallel_min_grain ? parallel_min_grain : grain;
+    }
+
+    /**
+     * @brief Divide `[begin, end)` a metà finché i pezzi superano `grain`, affidando le metà superiori al gruppo.
+     */
+    template <typename F>
+    void parallel_split(parallel::task_group& group, size_t begin, size_t end, size_t grain, const F& body)
+    {
+      // the upper halves go to the pool, where idle workers steal the largest ones first
+      while (end - begin > grain)
+      {
+        size_t middle = begin + (end - begin) / 2;
+        group.run([&group, middle, end, grain, &body]()
+                  { parallel_split(group, middle, end, grain, body); });
+        end = middle;
+      }
+
+      body(begin, end);
+    }
+
+    /**
+     * @brief Chiama `body(begin, end)` su pezzi di `[0, count)` grandi al più `grain`, in parallelo.
+     */
+    template <typename F>
+    void parallel_range(parallel::thread_pool& pool, size_t count, size_t grain, const F& body)
+    {
+      if (count == 0)
+        return;
+
+      if (count <= grain || pool.size() == 0)
+      {
+        body(0, count);
+        return;
+      }
+
+      parallel::task_group group(pool);
+      parallel_split(group, 0, count, grain, body);
+      group.wait();
+    }
+
+    /**
+     * @brief Fonde spostando `[a, aEnd)` e `[b, bEnd)` in `out`, dividendo le fusioni più grandi di `grain` tra i task del gruppo.
+     */
+    template <typename InputIt, typename OutputIt, typename Compare>
+    void parallel_merge(parallel::task_group& group, InputIt a, InputIt aEnd, InputIt b, InputIt bEnd, OutputIt out, size_t grain, const Compare& comp)
+    {
+      while (static_cast<size_t>((aEnd - a) + (bEnd - b)) > grain)
+      {
+        if (aEnd - a < bEnd - b)
+        {
+          std::swap(a, b);
+          std::swap(aEnd, bEnd);
+        }
+
+        // halve the longer run and cut the shorter one where the upper half starts; everything
+        // on the left then orders before everything on the right
+        InputIt aMiddle = a + (aEnd - a) / 2;
+        InputIt bMiddle = std::lower_bound(b, bEnd, *aMiddle, comp);
+        OutputIt outMiddle = out + (aMiddle - a) + (bMiddle - b);
+
+        group.run([&group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, &comp]()
+                  { parallel_merge(group, aMiddle, aEnd, bMiddle, bEnd, outMiddle, grain, comp); });
+        aEnd = aMiddle;
+        bEnd = bMiddle;
+      }
+
+      std::merge(std::make_move_iterator(a), std::make_move_iterator(aEnd), std::make_move_iterator(b), std::make_move_iterator(bEnd), out, comp);
+    }
+
+    /**
+     * @brief Buffer temporaneo di `parallel::sort`: memoria grezza che distrugge gli elementi costruiti e si libera da sola.
+     */
+    template <typename T>
+    struct sort_buffer
+    {
+      T* data;            /**< La memoria del buffer. */
+      size_t count;       /**< Numero di elementi per cui è allocata. */
+      size_t constructed; /**< Numero di elementi costruiti all'inizio del buffer. */
+
+      explicit sort_buffer(size_t count) : data(std::allocator<T>().allocate(count)), count(count), constructed(0)
+      {
+      }
+
+      sort_buffer(const sort_buffer&) = delete;
+      sort_buffer& operator=(const sort_buffer&) = delete;
+
+      ~sort_buffer()
+      {
+        if (!std::is_trivially_destructible<T>::value)
+        {
+          for (size_t i = 0; i < constructed; i++)
+            data[i].~T();
+        }
+        std::allocator<T>().deallocate(data, count);
+      }
+    };
+  } // namespace detail
+
+  namespace parallel
+  {
+    /**
+     * @brief Coda di un worker; allineata alla linea di cache perché le code vicine non si contendano la stessa linea.
+     */
+    struct alignas(64) thread_pool::queue
+    {
+      std::mutex mutex;                        /**< Protegge `tasks`. */
+      std::deque<std::function<void()>> tasks; /**< Il proprietario lavora sul fondo, i ladri prendono dalla testa. */
+    };
+
+    thread_pool::thread_pool(size_t workers)
+        : _queues(new queue[workers + 1]), _workers(workers), _threads(new std::thread[workers]), _queued(0), _sleeping(0), _stop(false)
+    {
+      size_t started = 0;
+      try
+      {
+        for (; started < workers; started++)
+          _threads[started] = std::thread(&thread_pool::work, this, started);
+      }
+      catch (...)
+      {
+        {
+          std::lock_guard<std::mutex> lock(_sleepMutex);
+          _stop.store(true);
+        }
+        _wake.notify_all();
+        for (size_t i = 0; i < started; i++)
+          _threads[i].join();
+        throw;
+      }
+    }
+
+    thread_pool::~thread_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop.store(true);
+      }
+      _wake.notify_all();
+
+      for (size_t i = 0; i < _workers; i++)
+        _threads[i].join();
+    }
+
+    size_t thread_pool::size() const noexcept
+    {
+      return _workers;
+    }
+
+    thread_pool& thread_pool::global()
+    {
+      // ZKL_THREADS overrides the core count, e.g. to measure scaling or to leave cores free
+      static thread_pool pool([]()
+                              {
+                                size_t threads = std::thread::hardware_concurrency();
+                                if (const char* value = std::getenv("ZKL_THREADS"))
+                                  threads = static_cast<size_t>(std::strtoul(value, nullptr, 10));
+                                return threads > 1 ? threads - 1 : 0; }());
+      return pool;
+    }
+
+    size_t thread_pool::own_queue() const noexcept
+    {
+      const detail::worker_identity& identity = detail::current_worker();
+      return identity.pool == this ? identity.index : _workers;
+    }
+
+    void thread_pool::submit(std::function<void()> task)
+    {
+      queue& own = _queues[own_queue()];
+      {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.push_back(std::move(task));
+      }
+
+      // pairs with the sleeping worker, which bumps _sleeping before re-checking _queued:
+      // at least one of the two sees the other's update, so no wake-up is lost
+      _queued.fetch_add(1);
+      if (_sleeping.load() > 0)
+      {
+        {
+          std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wake.notify_one();
+      }
+    }
+
+    bool thread_pool::run_one()
+    {
+      if (_queued.load(std::memory_order_relaxed) == 0)
+        return false;
+
+      std::function<void()> task;
+      size_t own = own_queue();
+
+      {
+        queue& q = _queues[own];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty())
+        {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        }
+      }
+
+      // steal the oldest task from the other queues, starting after our own so thieves spread out
+      for (size_t i = 1; !task && i <= _workers; i++)
+      {
+        queue& victim = _queues[(own + i) % (_workers + 1)];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+          task = std::move(victim.tasks.front());
+          victim.tasks.pop_front();
+        }
+      }
+
+      if (!task)
+        return false;
+
+      _queued.fetch_sub(1);
+      task();
+      return true;
+    }
+
+    void thread_pool::work(size_t index)
+    {
+      detail::current_worker() = {this, index};
+
+      size_t idle = 0;
+      while (!_stop.load())
+      {
+        if (run_one())
+        {
+          idle = 0;
+          continue;
+        }
+
+        // spin briefly before sleeping, since split tasks tend to arrive in bursts
+        if (++idle < 64)
+        {
+          std::this_thread::yield();
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleeping.fetch_add(1);
+        _wake.wait(lock, [this]()
+                   { return _stop.load() || _queued.load() > 0; });
+        _sleeping.fetch_sub(1);
+        idle = 0;
+      }
+    }
+
+    task_group::task_group(thread_pool& pool) : _pool(pool), _pending(0), _failed(false)
+    {
+    }
+
+    task_group::~task_group()
+    {
+      drain();
+    }
+
+    template <typename F>
+    void task_group::run(F&& task)
+    {
+      _pending.fetch_add(1, std::memory_order_relaxed);
+
+      try
+      {
+        _pool.submit([this, task = std::forward<F>(task)]() mutable
+                     {
+                       try
+                       {
+                         task();
+                       }
+                       catch (...)
+                       {
+                         if (!_failed.exchange(true))
+                           _exception = std::current_exception();
+                       }
+                       _pending.fetch_sub(1, std::memory_order_release); });
+      }
+      catch (...)
+      {
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+      }
+    }
+
+    void task_group::drain() noexcept
+    {
+      while (_pending.load(std::memory_order_acquire) != 0)
+      {
+        if (!_pool.run_one())
+          std::this_thread::yield();
+      }
+    }
+
+    void task_group::wait()
+    {
+      drain();
+
+      if (_failed.load())
+      {
+        std::exception_ptr exception = _exception;
+        _exception = nullptr;
+        _failed.store(false);
+        std::rethrow_exception(exception);
+      }
+    }
+
+    template <typename RandomIt, typename F>
+    void for_each(RandomIt first, RandomIt last, F f)
+    {
+      thread_pool& pool = thread_pool::global();
+      size_t count = static_cast<size_t>(last - first);
+
+      detail::parallel_range(pool, count, detail::parallel_grain(count, pool), [first, &f](size_t begin, size_t end)
+                             {
+                               for (RandomIt it = first + begin, stop = first + end; it != stop; ++it)
+                                 f(*it); });
+    }
+
+    template <typename Range, typename F, typename>
+    void for_each(Range& range, F f)
+    {
+      parallel::for_each(range.begin(), range.end(), std::ref(f));
+    }
+
+    template <typename RandomIt, typename OutputIt, typename UnaryOp>
+    OutputIt transform(RandomIt first, RandomIt last, OutputIt out, UnaryOp op)
+    {
+      thread_pool& pool = thread_pool::global();
+      size_t count = static_cast<size_t>(last - first);
+
+      detail::parallel_range(pool, count, detail::parallel_grain(count, pool), [first, out, &op](size_t begin, size_t end)
+                             {
+                               OutputIt to = out + begin;
+                               for (RandomIt it = first + begin, stop = first + end; it != stop; ++it, ++to)
+                                 *to = op(*it); });
+
+      return out + count;
+    }
+
+    template <typename Range, typename OutRange, typename UnaryOp, typename>
+    void transform(Range& range, OutRange& out, UnaryOp op)
+    {
+      if (out.size() < range.size())
+      {
+        throw std::length_error("Output range too short");
+      }
+
+      parallel::transform(range.begin(), range.end(), out.begin(), std::ref(op));
+    }
+
+    template <typename RandomIt, typename T, typename BinaryOp>
+    T reduce(RandomIt first, RandomIt last, T init, BinaryOp op)
+    {
+      thread_pool& pool = thread_pool::global();
+      size_t count = static_cast<size_t>(last - first);
+      if (count == 0)
+        return init;
+
+      // fixed pieces, so each partial result has a slot and they combine in order
+      size_t grain = detail::parallel_grain(count, pool);
+      size_t pieces = (count + grain - 1) / grain;
+      zkl::vector<std::optional<T>> partials;
+      partials.resize(pieces);
+
+      detail::parallel_range(pool, pieces, 1, [first, count, grain, &op, &partials](size_t begin, size_t end)
+                             {
+                               for (size_t piece = begin; piece < end; piece++)
+                               {
+                                 size_t from = piece * grain;
+                                 size_t to = from + grain < count ? from + grain : count;
+
+                                 T partial(first[from]);
+                                 for (size_t i = from + 1; i < to; i++)
+                                   partial = op(std::move(partial), first[i]);
+                                 partials[piece].emplace(std::move(partial));
+                               } });
+
+      T result = std::move(init);
+      for (size_t piece = 0; piece < pieces; piece++)
+        result = op(std::move(result), std::move(*partials[piece]));
+      return result;
+    }
+
+    template <typename Range, typename T, typename BinaryOp, typename>
+    T reduce(const Range& range, T init, BinaryOp op)
+    {
+      return parallel::reduce(range.begin(), range.end(), std::move(init), std::ref(op));
+    }
+
+    template <typename RandomIt, typename Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp)
+    {
+      typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+      thread_pool& pool = thread_pool::global();
+      size_t count = static_cast<size_t>(last - first);
+
+      // the merge passes move elements through a buffer, which is only safe if moves cannot throw
+      if constexpr (!std::is_nothrow_move_constructible<value_type>::value || !std::is_nothrow_move_assignable<value_type>::value)
+      {
+        std::sort(first, last, comp);
+      }
+      else
+      {
+        if (pool.size() == 0 || count <= 2 * detail::parallel_min_grain)
+        {
+          std::sort(first, last, comp);
+          return;
+        }
+
+        // one run per thread, rounded up to a power of two so that runs merge in pairs
+        size_t runs = 1;
+        while (runs < pool.size() + 1)
+          runs *= 2;
+
+        auto bound = [count, runs](size_t run)
+        { return count * run / runs; };
+
+        detail::parallel_range(pool, runs, 1, [first, &bound, &comp](size_t begin, size_t end)
+                               {
+                                 for (size_t run = begin; run < end; run++)
+                                   std::sort(first + bound(run), first + bound(run + 1), comp); });
+
+        size_t grain = detail::parallel_grain(count, pool);
+        detail::sort_buffer<value_type> buffer(count);
+        value_type* scratch = buffer.data;
+        detail::parallel_range(pool, count, grain, [first, scratch](size_t begin, size_t end)
+                               {
+                                 for (size_t i = begin; i < end; i++)
+                                   ::new (static_cast<void*>(scratch + i)) value_type(std::move(first[i])); });
+        buffer.constructed = count;
+
+        // each pass merges pairs of runs from one side into the other, so the passes alternate
+        bool inBuffer = true;
+        for (size_t width = 1; width < runs; width *= 2)
+        {
+          task_group group(pool);
+          for (size_t run = 0; run < runs; run += 2 * width)
+          {
+            size_t low = bound(run);
+            size_t middle = bound(run + width);
+            size_t high = bound(run + 2 * width);
+
+            group.run([&group, first, scratch, low, middle, high, grain, &comp, inBuffer]()
+                      {
+                        if (inBuffer)
+                          detail::parallel_merge(group, scratch + low, scratch + middle, scratch + middle, scratch + high, first + low, grain, comp);
+                        else
+                          detail::parallel_merge(group, first + low, first + middle, first + middle, first + high, scratch + low, grain, comp); });
+          }
+          group.wait();
+          inBuffer = !inBuffer;
+        }
+
+        if (inBuffer)
+        {
+          detail::parallel_range(pool, count, grain, [first, scratch](size_t begin, size_t end)
+                                 {
+                                   for (size_t i = begin; i < end; i++)
+                                     first[i] = std::move(scratch[i]); });
+        }
+      }
+    }
+
+    template <typename Range, typename Compare, typename>
+    void sort(Range& range, Compare comp)
+    {
+      parallel::sort(range.begin(), range.end(), std::ref(comp));
+    }
+  } // namespace parallel
+} // namespace zkl
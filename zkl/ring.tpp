@@ -0,0 +1,420 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace zkl
+{
+  namespace detail
+  {
+    size_t ring_capacity(size_t capacity)
+    {
+      if (capacity > (static_cast<size_t>(-1) >> 1) + 1)
+      {
+        throw std::length_error("Ring too large");
+      }
+
+      size_t rounded = 2;
+      while (rounded < capacity)
+        rounded *= 2;
+      return rounded;
+    }
+  } // namespace detail
+
+  template <typename T, typename Allocator>
+  spsc_ring<T, Allocator>::spsc_ring(size_t capacity, const Allocator& allocator)
+      : _slots(nullptr), _mask(detail::ring_capacity(capacity) - 1), _allocator(allocator), _tail(0), _cachedHead(0), _head(0), _cachedTail(0)
+  {
+    _slots = alloc_traits::allocate(_allocator, _mask + 1);
+  }
+
+  template <typename T, typename Allocator>
+  spsc_ring<T, Allocator>::~spsc_ring()
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    for (size_t position = _head.load(std::memory_order_relaxed); position != tail; position++)
+      alloc_traits::destroy(_allocator, _slots + (position & _mask));
+
+    alloc_traits::deallocate(_allocator, _slots, _mask + 1);
+  }
+
+  template <typename T, typename Allocator>
+  size_t spsc_ring<T, Allocator>::free_slots(size_t tail, size_t wanted) noexcept
+  {
+    size_t free = _mask + 1 - (tail - _cachedHead);
+    if (free < wanted)
+    {
+      // only touch the consumer's cache line when the stale copy is not enough
+      _cachedHead = _head.load(std::memory_order_acquire);
+      free = _mask + 1 - (tail - _cachedHead);
+    }
+
+    return free;
+  }
+
+  template <typename T, typename Allocator>
+  size_t spsc_ring<T, Allocator>::ready_slots(size_t head, size_t wanted) noexcept
+  {
+    size_t ready = _cachedTail - head;
+    if (ready < wanted)
+    {
+      _cachedTail = _tail.load(std::memory_order_acquire);
+      ready = _cachedTail - head;
+    }
+
+    return ready;
+  }
+
+  template <typename T, typename Allocator>
+  bool spsc_ring<T, Allocator>::try_push(const T& value)
+  {
+    return try_emplace(value);
+  }
+
+  template <typename T, typename Allocator>
+  bool spsc_ring<T, Allocator>::try_push(T&& value)
+  {
+    return try_emplace(std::move(value));
+  }
+
+  template <typename T, typename Allocator>
+  template <typename... Args>
+  bool spsc_ring<T, Allocator>::try_emplace(Args&&... args)
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0)
+      return false;
+
+    alloc_traits::construct(_allocator, _slots + (tail & _mask), std::forward<Args>(args)...);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, typename Allocator>
+  template <typename InputIt>
+  size_t spsc_ring<T, Allocator>::push_n(InputIt first, size_t count)
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    size_t pushed = free_slots(tail, count);
+    if (pushed > count)
+      pushed = count;
+
+    size_t constructed = 0;
+    try
+    {
+      for (; constructed < pushed; constructed++, ++first)
+        alloc_traits::construct(_allocator, _slots + ((tail + constructed) & _mask), *first);
+    }
+    catch (...)
+    {
+      // the elements built so far stay in the queue
+      _tail.store(tail + constructed, std::memory_order_release);
+      throw;
+    }
+
+    _tail.store(tail + pushed, std::memory_order_release);
+    return pushed;
+  }
+
+  template <typename T, typename Allocator>
+  bool spsc_ring<T, Allocator>::try_pop(T& out)
+  {
+    size_t head = _head.load(std::memory_order_relaxed);
+    if (ready_slots(head, 1) == 0)
+      return false;
+
+    T* slot = _slots + (head & _mask);
+    out = std::move(*slot);
+    alloc_traits::destroy(_allocator, slot);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, typename Allocator>
+  template <typename OutputIt>
+  size_t spsc_ring<T, Allocator>::pop_n(OutputIt out, size_t count)
+  {
+    size_t head = _head.load(std::memory_order_relaxed);
+    size_t popped = ready_slots(head, count);
+    if (popped > count)
+      popped = count;
+
+    size_t moved = 0;
+    try
+    {
+      for (; moved < popped; moved++, ++out)
+      {
+        T* slot = _slots + ((head + moved) & _mask);
+        *out = std::move(*slot);
+        alloc_traits::destroy(_allocator, slot);
+      }
+    }
+    catch (...)
+    {
+      // the element whose move threw stays at the front of the queue
+      _head.store(head + moved, std::memory_order_release);
+      throw;
+    }
+
+    _head.store(head + popped, std::memory_order_release);
+    return popped;
+  }
+
+  template <typename T, typename Allocator>
+  size_t spsc_ring<T, Allocator>::size() const noexcept
+  {
+    size_t head = _head.load(std::memory_order_acquire);
+    size_t tail = _tail.load(std::memory_order_acquire);
+    // head is read first and only grows up to tail, so the difference is never negative
+    return tail - head > _mask ? _mask + 1 : tail - head;
+  }
+
+  template <typename T, typename Allocator>
+  bool spsc_ring<T, Allocator>::empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  template <typename T, typename Allocator>
+  size_t spsc_ring<T, Allocator>::capacity() const noexcept
+  {
+    return _mask + 1;
+  }
+
+  template <typename T, typename Allocator>
+  mpmc_ring<T, Allocator>::mpmc_ring(size_t capacity, const Allocator& allocator)
+      : _cells(nullptr), _mask(detail::ring_capacity(capacity) - 1), _allocator(allocator), _tail(0), _head(0)
+  {
+    cell_allocator cells(_allocator);
+    _cells = cell_traits::allocate(cells, _mask + 1);
+
+    for (size_t i = 0; i <= _mask; i++)
+    {
+      ::new (static_cast<void*>(_cells + i)) cell;
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T, typename Allocator>
+  mpmc_ring<T, Allocator>::~mpmc_ring()
+  {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    for (size_t position = _head.load(std::memory_order_relaxed); position != tail; position++)
+      alloc_traits::destroy(_allocator, element(_cells[position & _mask]));
+
+    cell_allocator cells(_allocator);
+    cell_traits::deallocate(cells, _cells, _mask + 1);
+  }
+
+  template <typename T, typename Allocator>
+  T* mpmc_ring<T, Allocator>::element(cell& c) noexcept
+  {
+    return reinterpret_cast<T*>(c.storage);
+  }
+
+  template <typename T, typename Allocator>
+  size_t mpmc_ring<T, Allocator>::claim_push(size_t count, size_t& first) noexcept
+  {
+    size_t position = _tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      size_t sequence = _cells[position & _mask].sequence.load(std::memory_order_acquire);
+      ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - position);
+
+      // behind: the cell still holds the previous lap's element, so the queue is full
+      if (difference < 0)
+        return 0;
+
+      // ahead: another producer already took this position
+      if (difference > 0)
+      {
+        position = _tail.load(std::memory_order_relaxed);
+        continue;
+      }
+
+      size_t claimed = 1;
+      while (claimed < count && _cells[(position + claimed) & _mask].sequence.load(std::memory_order_acquire) == position + claimed)
+        claimed++;
+
+      if (_tail.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+      {
+        first = position;
+        return claimed;
+      }
+    }
+  }
+
+  template <typename T, typename Allocator>
+  size_t mpmc_ring<T, Allocator>::claim_pop(size_t count, size_t& first) noexcept
+  {
+    size_t position = _head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      size_t sequence = _cells[position & _mask].sequence.load(std::memory_order_acquire);
+      ptrdiff_t difference = static_cast<ptrdiff_t>(sequence - (position + 1));
+
+      // behind: the producer has not filled this cell yet, so the queue is empty
+      if (difference < 0)
+        return 0;
+
+      // ahead: another consumer already took this position
+      if (difference > 0)
+      {
+        position = _head.load(std::memory_order_relaxed);
+        continue;
+      }
+
+      size_t claimed = 1;
+      while (claimed < count && _cells[(position + claimed) & _mask].sequence.load(std::memory_order_acquire) == position + claimed + 1)
+        claimed++;
+
+      if (_head.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+      {
+        first = position;
+        return claimed;
+      }
+    }
+  }
+
+  template <typename T, typename Allocator>
+  bool mpmc_ring<T, Allocator>::try_push(const T& value)
+  {
+    return try_emplace(value);
+  }
+
+  template <typename T, typename Allocator>
+  bool mpmc_ring<T, Allocator>::try_push(T&& value)
+  {
+    return try_emplace(std::move(value));
+  }
+
+  template <typename T, typename Allocator>
+  template <typename... Args>
+  bool mpmc_ring<T, Allocator>::try_emplace(Args&&... args)
+  {
+    if constexpr (!std::is_nothrow_constructible<T, Args&&...>::value)
+    {
+      // a claimed cell must always be published, so anything that can throw happens first
+      T value(std::forward<Args>(args)...);
+      return try_emplace(std::move(value));
+    }
+    else
+    {
+      size_t position;
+      if (claim_push(1, position) == 0)
+        return false;
+
+      cell& c = _cells[position & _mask];
+      alloc_traits::construct(_allocator, element(c), std::forward<Args>(args)...);
+      c.sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+  }
+
+  template <typename T, typename Allocator>
+  template <typename InputIt>
+  size_t mpmc_ring<T, Allocator>::push_n(InputIt first, size_t count)
+  {
+    if (count == 0)
+      return 0;
+
+    if constexpr (!std::is_nothrow_constructible<T, decltype(*first)>::value)
+    {
+      // copies that can throw are made one at a time, before each cell is claimed
+      size_t pushed = 0;
+      for (; pushed < count; pushed++, ++first)
+      {
+        if (!try_emplace(*first))
+          break;
+      }
+      return pushed;
+    }
+    else
+    {
+      size_t position;
+      size_t claimed = claim_push(count, position);
+
+      for (size_t i = 0; i < claimed; i++, ++first)
+      {
+        cell& c = _cells[(position + i) & _mask];
+        alloc_traits::construct(_allocator, element(c), *first);
+        c.sequence.store(position + i + 1, std::memory_order_release);
+      }
+
+      return claimed;
+    }
+  }
+
+  template <typename T, typename Allocator>
+  bool mpmc_ring<T, Allocator>::try_pop(T& out)
+  {
+    size_t position;
+    if (claim_pop(1, position) == 0)
+      return false;
+
+    cell& c = _cells[position & _mask];
+    out = std::move(*element(c));
+    alloc_traits::destroy(_allocator, element(c));
+    c.sequence.store(position + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, typename Allocator>
+  template <typename OutputIt>
+  size_t mpmc_ring<T, Allocator>::pop_n(OutputIt out, size_t count)
+  {
+    if (count == 0)
+      return 0;
+
+    size_t position;
+    size_t claimed = claim_pop(count, position);
+
+    size_t i = 0;
+    try
+    {
+      for (; i < claimed; i++, ++out)
+      {
+        cell& c = _cells[(position + i) & _mask];
+        *out = std::move(*element(c));
+        alloc_traits::destroy(_allocator, element(c));
+        c.sequence.store(position + i + 1 + _mask, std::memory_order_release);
+      }
+    }
+    catch (...)
+    {
+      // claimed cells must be released or producers stall on them; the rest of the batch is dropped
+      for (; i < claimed; i++)
+      {
+        cell& c = _cells[(position + i) & _mask];
+        alloc_traits::destroy(_allocator, element(c));
+        c.sequence.store(position + i + 1 + _mask, std::memory_order_release);
+      }
+      throw;
+    }
+
+    return claimed;
+  }
+
+  template <typename T, typename Allocator>
+  size_t mpmc_ring<T, Allocator>::size() const noexcept
+  {
+    size_t head = _head.load(std::memory_order_acquire);
+    size_t tail = _tail.load(std::memory_order_acquire);
+    // head is read first and only grows up to tail, so the difference is never negative
+    return tail - head > _mask ? _mask + 1 : tail - head;
+  }
+
+  template <typename T, typename Allocator>
+  bool mpmc_ring<T, Allocator>::empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  template <typename T, typename Allocator>
+  size_t mpmc_ring<T, Allocator>::capacity() const noexcept
+  {
+    return _mask + 1;
+  }
+} // namespace zkl
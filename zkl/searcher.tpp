@@ -0,0 +1,139 @@
+#pragma once
+
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <cstring>
+
+namespace zkl
+{
+  namespace detail
+  {
+    /**
+     * @brief Costruisce la tabella degli spostamenti di Boyer–Moore–Horspool.
+     *
+     * `shift[c]` è la distanza dell'ultima occorrenza di `c` in `pattern[0, m - 1)` dalla fine del pattern, o `m`.
+     */
+    void build_shift_table(const char* pattern, size_t m, size_t* shift)
+    {
+      for (size_t c = 0; c < 256; c++)
+        shift[c] = m;
+
+      for (size_t i = 0; i + 1 < m; i++)
+        shift[static_cast<unsigned char>(pattern[i])] = m - 1 - i;
+    }
+
+    /**
+     * @brief Costruisce la tabella degli spostamenti per la ricerca all'indietro.
+     *
+     * `rshift[c]` è l'indice della prima occorrenza di `c` in `pattern[1, m)`, o `m`.
+     */
+    void build_rshift_table(const char* pattern, size_t m, size_t* rshift)
+    {
+      for (size_t c = 0; c < 256; c++)
+        rshift[c] = m;
+
+      for (size_t i = m; i-- > 1;)
+        rshift[static_cast<unsigned char>(pattern[i])] = i;
+    }
+
+    /**
+     * @brief Cerca la prima occorrenza di `pattern` in `text` a partire da `pos`.
+     *
+     * Usa i kernel SIMD per saltare direttamente al prossimo candidato con il primo carattere
+     * corretto, poi verifica l'ultimo carattere e il resto con memcmp. In caso di mancata
+     * corrispondenza avanza dello spostamento di Horspool se `shift` è disponibile.
+     *
+     * @return L'indice della prima occorrenza, o `not_found`.
+     */
+    size_t search_forward(const char* text, size_t n, size_t pos, const char* pattern, size_t m, const size_t* shift)
+    {
+      if (pos > n || m > n - pos)
+        return not_found;
+      if (m == 0)
+        return pos;
+
+      const char_search_kernels& kernels = char_search();
+      const char first = pattern[0];
+      const char last = pattern[m - 1];
+      const size_t lastStart = n - m;
+
+      size_t s = pos;
+      while (s <= lastStart)
+      {
+        size_t skip = kernels.find(text + s, lastStart - s + 1, first);
+        if (skip == not_found)
+          return not_found;
+        s += skip;
+
+        if (text[s + m - 1] == last && std::memcmp(text + s + 1, pattern + 1, m - 1) == 0)
+          return s;
+
+        s += (shift != nullptr) ? shift[static_cast<unsigned char>(text[s + m - 1])] : 1;
+      }
+
+      return not_found;
+    }
+
+    /**
+     * @brief Cerca l'ultima occorrenza di `pattern` in `text` che inizia al più in `pos`.
+     *
+     * Simmetrica a `search_forward`: il prefiltro SIMD cerca all'indietro l'ultimo carattere
+     * del pattern e lo spostamento usa il primo carattere della finestra.
+     *
+     * @return L'indice dell'ultima occorrenza, o `not_found`.
+     */
+    size_t search_backward(const char* text, size_t n, size_t pos, const char* pattern, size_t m, const size_t* rshift)
+    {
+      if (m > n)
+        return not_found;
+
+      size_t s = (pos < n - m) ? pos : n - m;
+      if (m == 0)
+        return s;
+
+      const char_search_kernels& kernels = char_search();
+      const char first = pattern[0];
+      const char last = pattern[m - 1];
+
+      while (true)
+      {
+        // window starts are shifted by m - 1 so the kernel looks at their last byte
+        size_t found = kernels.rfind(text + m - 1, s + 1, last);
+        if (found == not_found)
+          return not_found;
+        s = found;
+
+        if (text[s] == first && std::memcmp(text + s, pattern, m - 1) == 0)
+          return s;
+
+        size_t step = (rshift != nullptr) ? rshift[static_cast<unsigned char>(text[s])] : 1;
+        if (step > s)
+          return not_found;
+        s -= step;
+      }
+    }
+  } // namespace detail
+
+  searcher::searcher(string_view pattern) : _pattern(pattern)
+  {
+    detail::build_shift_table(_pattern.data(), _pattern.size(), _shift);
+    detail::build_rshift_table(_pattern.data(), _pattern.size(), _rshift);
+  }
+
+  const string& searcher::pattern() const noexcept
+  {
+    return _pattern;
+  }
+
+  size_t searcher::find(string_view text, size_t pos) const noexcept
+  {
+    size_t found = detail::search_forward(text.data(), text.size(), pos, _pattern.data(), _pattern.size(), _shift);
+    return found == detail::not_found ? string::npos : found;
+  }
+
+  size_t searcher::rfind(string_view text, size_t pos) const noexcept
+  {
+    size_t found = detail::search_backward(text.data(), text.size(), pos, _pattern.data(), _pattern.size(), _rshift);
+    return found == detail::not_found ? string::npos : found;
+  }
+} // namespace zkl
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace zkl
+{
+  /**
+   * @brief Intestazione del buffer condiviso, seguita in memoria dai caratteri e dal terminatore.
+   */
+  struct shared_string::block
+  {
+    std::atomic<size_t> refs; /**< Numero di `shared_string` che puntano a questo blocco. */
+    size_t size;              /**< Numero di caratteri. */
+
+    char* chars()
+    {
+      return reinterpret_cast<char*>(this + 1);
+    }
+  };
+
+  shared_string::block* shared_string::make_block(const char* str, size_t n)
+  {
+    if (n == 0)
+      return nullptr;
+
+    // header and characters share a single allocation
+    void* memory = ::operator new(sizeof(block) + n + 1);
+    block* b = new (memory) block;
+    b->refs.store(1, std::memory_order_relaxed);
+    b->size = n;
+    std::memcpy(b->chars(), str, n);
+    b->chars()[n] = 0;
+
+    return b;
+  }
+
+  void shared_string::release() noexcept
+  {
+    if (_block == nullptr)
+      return;
+
+    // acq_rel so the last owner sees every other owner's reads finished
+    if (_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      _block->~block();
+      ::operator delete(_block);
+    }
+
+    _block = nullptr;
+  }
+
+  shared_string::shared_string() noexcept : _block(nullptr)
+  {
+  }
+
+  shared_string::shared_string(const char* str) : _block(make_block(str, std::strlen(str)))
+  {
+  }
+
+  shared_string::shared_string(string_view sv) : _block(make_block(sv.data(), sv.size()))
+  {
+  }
+
+  shared_string::shared_string(const string& str) : _block(make_block(str.data(), str.size()))
+  {
+  }
+
+  shared_string::shared_string(const shared_string& other) noexcept : _block(other._block)
+  {
+    if (_block != nullptr)
+      _block->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  shared_string::shared_string(shared_string&& other) noexcept : _block(other._block)
+  {
+    other._block = nullptr;
+  }
+
+  shared_string::~shared_string()
+  {
+    release();
+  }
+
+  shared_string& shared_string::operator=(const shared_string& other) noexcept
+  {
+    if (_block != other._block)
+    {
+      if (other._block != nullptr)
+        other._block->refs.fetch_add(1, std::memory_order_relaxed);
+
+      release();
+      _block = other._block;
+    }
+
+    return *this;
+  }
+
+  shared_string& shared_string::operator=(shared_string&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      _block = other._block;
+      other._block = nullptr;
+    }
+
+    return *this;
+  }
+
+  size_t shared_string::size() const noexcept
+  {
+    return _block != nullptr ? _block->size : 0;
+  }
+
+  size_t shared_string::length() const noexcept
+  {
+    return size();
+  }
+
+  bool shared_string::empty() const noexcept
+  {
+    return _block == nullptr;
+  }
+
+  const char& shared_string::operator[](const size_t index) const
+  {
+    return data()[index];
+  }
+
+  const char* shared_string::c_str() const noexcept
+  {
+    return _block != nullptr ? _block->chars() : "";
+  }
+
+  const char* shared_string::data() const noexcept
+  {
+    return c_str();
+  }
+
+  size_t shared_string::use_count() const noexcept
+  {
+    return _block != nullptr ? _block->refs.load(std::memory_order_relaxed) : 0;
+  }
+
+  string shared_string::str() const
+  {
+    return string(string_view(*this));
+  }
+
+  shared_string::operator string_view() const noexcept
+  {
+    return string_view(data(), size());
+  }
+} // namespace zkl
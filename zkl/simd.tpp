@@ -0,0 +1,499 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define ZKL_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zkl
+{
+  namespace detail
+  {
+    /** Valore restituito dai kernel di ricerca quando nessun carattere corrisponde. */
+    static const size_t not_found = static_cast<size_t>(-1);
+
+    /**
+     * @brief Firma comune dei kernel di ricerca di un singolo carattere.
+     *
+     * Ogni kernel cerca in `data[0, n)` e restituisce l'indice trovato, o `not_found`.
+     */
+    typedef size_t (*char_search_fn)(const char* data, size_t n, char c);
+
+    /**
+     * @brief Insieme dei kernel di ricerca selezionati per la CPU corrente.
+     */
+    struct char_search_kernels
+    {
+      char_search_fn find;      /**< Primo carattere uguale a `c`. */
+      char_search_fn rfind;     /**< Ultimo carattere uguale a `c`. */
+      char_search_fn find_not;  /**< Primo carattere diverso da `c`. */
+      char_search_fn rfind_not; /**< Ultimo carattere diverso da `c`. */
+    };
+
+    /**
+     * @brief Firma comune dei kernel di ricerca per classe di caratteri.
+     *
+     * La classe è descritta da due tabelle di 16 byte indicizzate dai nibble basso e alto:
+     * il byte `x` appartiene alla classe se `lo[x & 15] & hi[x >> 4]` è diverso da zero.
+     * Ogni kernel cerca in `data[0, n)` e restituisce l'indice trovato, o `not_found`.
+     */
+    typedef size_t (*class_search_fn)(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi);
+
+    /**
+     * @brief Insieme dei kernel di ricerca per classe selezionati per la CPU corrente.
+     */
+    struct class_search_kernels
+    {
+      class_search_fn find;      /**< Primo carattere nella classe. */
+      class_search_fn rfind;     /**< Ultimo carattere nella classe. */
+      class_search_fn find_not;  /**< Primo carattere fuori dalla classe. */
+      class_search_fn rfind_not; /**< Ultimo carattere fuori dalla classe. */
+    };
+
+    /**
+     * @brief Firma comune dei kernel di accumulo dell'hash per input lunghi.
+     *
+     * Elabora `stripes` blocchi consecutivi di 64 byte: per il blocco `s` e la parola `i` calcola
+     * `k = d ^ secret[s + i]`, somma `d` alla corsia `i ^ 1` e `lo32(k) * hi32(k)` alla corsia `i`
+     * degli 8 accumulatori `acc`. Tutti i kernel producono lo stesso risultato.
+     */
+    typedef void (*hash_accumulate_fn)(uint64_t* acc, const char* data, size_t stripes, const uint64_t* secret);
+
+    /** Byte di controllo di `flat_hash_map`: i valori non negativi indicano una cella piena. */
+    static const int8_t ctrl_empty = -128;  /**< Cella mai occupata: la ricerca può fermarsi. */
+    static const int8_t ctrl_deleted = -2;  /**< Cella liberata: la ricerca deve proseguire. */
+    static const int8_t ctrl_sentinel = -1; /**< Byte dopo l'ultima cella, ferma gli iteratori. */
+
+    /** Numero di byte di controllo esaminati insieme. */
+    static const size_t group_width = 16;
+
+    /**
+     * @brief Restituisce la maschera dei byte di `ctrl[0, 16)` uguali a `value`.
+     */
+    inline unsigned group_match(const int8_t* ctrl, int8_t value)
+    {
+#ifdef ZKL_SIMD_X86
+      __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+      return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#else
+      unsigned mask = 0;
+      for (size_t i = 0; i < group_width; i++)
+      {
+        if (ctrl[i] == value)
+          mask |= 1u << i;
+      }
+      return mask;
+#endif
+    }
+
+    /**
+     * @brief Restituisce la maschera delle celle vuote o cancellate di `ctrl[0, 16)`.
+     */
+    inline unsigned group_match_free(const int8_t* ctrl)
+    {
+#ifdef ZKL_SIMD_X86
+      __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+      return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), group)));
+#else
+      unsigned mask = 0;
+      for (size_t i = 0; i < group_width; i++)
+      {
+        if (ctrl[i] < ctrl_sentinel)
+          mask |= 1u << i;
+      }
+      return mask;
+#endif
+    }
+
+    template <bool Not>
+    size_t find_char_scalar(const char* data, size_t n, char c)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        if ((data[i] == c) != Not)
+          return i;
+      }
+
+      return not_found;
+    }
+
+    template <bool Not>
+    size_t rfind_char_scalar(const char* data, size_t n, char c)
+    {
+      for (size_t i = n; i-- > 0;)
+      {
+        if ((data[i] == c) != Not)
+          return i;
+      }
+
+      return not_found;
+    }
+
+    template <bool Not>
+    size_t find_class_scalar(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        unsigned char x = static_cast<unsigned char>(data[i]);
+        if (((lo[x & 15] & hi[x >> 4]) != 0) != Not)
+          return i;
+      }
+
+      return not_found;
+    }
+
+    template <bool Not>
+    size_t rfind_class_scalar(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      for (size_t i = n; i-- > 0;)
+      {
+        unsigned char x = static_cast<unsigned char>(data[i]);
+        if (((lo[x & 15] & hi[x >> 4]) != 0) != Not)
+          return i;
+      }
+
+      return not_found;
+    }
+
+    inline uint64_t read_u64(const char* p)
+    {
+      uint64_t value;
+      std::memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    void hash_accumulate_scalar(uint64_t* acc, const char* data, size_t stripes, const uint64_t* secret)
+    {
+      for (size_t s = 0; s < stripes; s++)
+      {
+        const char* stripe = data + s * 64;
+        for (size_t i = 0; i < 8; i++)
+        {
+          uint64_t d = read_u64(stripe + i * 8);
+          uint64_t k = d ^ secret[s + i];
+          acc[i ^ 1] += d;
+          acc[i] += (k & 0xFFFFFFFFu) * (k >> 32);
+        }
+      }
+    }
+
+#ifdef ZKL_SIMD_X86
+    template <bool Not>
+    size_t find_char_sse2(const char* data, size_t n, char c)
+    {
+      const __m128i needle = _mm_set1_epi8(c);
+      size_t i = 0;
+
+      for (; i + 16 <= n; i += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (Not)
+          mask ^= 0xFFFFu;
+        if (mask != 0)
+          return i + __builtin_ctz(mask);
+      }
+
+      size_t tail = find_char_scalar<Not>(data + i, n - i, c);
+      return tail == not_found ? not_found : i + tail;
+    }
+
+    template <bool Not>
+    size_t rfind_char_sse2(const char* data, size_t n, char c)
+    {
+      const __m128i needle = _mm_set1_epi8(c);
+      size_t i = n;
+
+      for (; i >= 16; i -= 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 16));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (Not)
+          mask ^= 0xFFFFu;
+        if (mask != 0)
+          return i - 16 + (31 - __builtin_clz(mask));
+      }
+
+      return rfind_char_scalar<Not>(data, i, c);
+    }
+
+    template <bool Not>
+    __attribute__((target("avx2"))) size_t find_char_avx2(const char* data, size_t n, char c)
+    {
+      const __m256i needle = _mm256_set1_epi8(c);
+      size_t i = 0;
+
+      for (; i + 32 <= n; i += 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (Not)
+          mask = ~mask;
+        if (mask != 0)
+          return i + __builtin_ctz(mask);
+      }
+
+      size_t tail = find_char_sse2<Not>(data + i, n - i, c);
+      return tail == not_found ? not_found : i + tail;
+    }
+
+    template <bool Not>
+    __attribute__((target("avx2"))) size_t rfind_char_avx2(const char* data, size_t n, char c)
+    {
+      const __m256i needle = _mm256_set1_epi8(c);
+      size_t i = n;
+
+      for (; i >= 32; i -= 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 32));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (Not)
+          mask = ~mask;
+        if (mask != 0)
+          return i - 32 + (31 - __builtin_clz(mask));
+      }
+
+      return rfind_char_sse2<Not>(data, i, c);
+    }
+
+    /**
+     * @brief Classifica 16 byte: restituisce la maschera dei byte che appartengono alla classe.
+     */
+    __attribute__((target("ssse3"))) inline unsigned classify_ssse3(__m128i block, __m128i loTable, __m128i hiTable)
+    {
+      const __m128i nibble = _mm_set1_epi8(0x0F);
+      __m128i loIndex = _mm_and_si128(block, nibble);
+      __m128i hiIndex = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+      __m128i bits = _mm_and_si128(_mm_shuffle_epi8(loTable, loIndex), _mm_shuffle_epi8(hiTable, hiIndex));
+      return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128()))) & 0xFFFFu;
+    }
+
+    template <bool Not>
+    __attribute__((target("ssse3"))) size_t find_class_ssse3(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      const __m128i loTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+      const __m128i hiTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+      size_t i = 0;
+
+      for (; i + 16 <= n; i += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned mask = classify_ssse3(block, loTable, hiTable);
+        if (Not)
+          mask ^= 0xFFFFu;
+        if (mask != 0)
+          return i + __builtin_ctz(mask);
+      }
+
+      size_t tail = find_class_scalar<Not>(data + i, n - i, lo, hi);
+      return tail == not_found ? not_found : i + tail;
+    }
+
+    template <bool Not>
+    __attribute__((target("ssse3"))) size_t rfind_class_ssse3(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      const __m128i loTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+      const __m128i hiTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+      size_t i = n;
+
+      for (; i >= 16; i -= 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 16));
+        unsigned mask = classify_ssse3(block, loTable, hiTable);
+        if (Not)
+          mask ^= 0xFFFFu;
+        if (mask != 0)
+          return i - 16 + (31 - __builtin_clz(mask));
+      }
+
+      return rfind_class_scalar<Not>(data, i, lo, hi);
+    }
+
+    /**
+     * @brief Classifica 32 byte: restituisce la maschera dei byte che appartengono alla classe.
+     */
+    __attribute__((target("avx2"))) inline unsigned classify_avx2(__m256i block, __m256i loTable, __m256i hiTable)
+    {
+      const __m256i nibble = _mm256_set1_epi8(0x0F);
+      __m256i loIndex = _mm256_and_si256(block, nibble);
+      __m256i hiIndex = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+      __m256i bits = _mm256_and_si256(_mm256_shuffle_epi8(loTable, loIndex), _mm256_shuffle_epi8(hiTable, hiIndex));
+      return ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bits, _mm256_setzero_si256())));
+    }
+
+    template <bool Not>
+    __attribute__((target("avx2"))) size_t find_class_avx2(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      const __m256i loTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo)));
+      const __m256i hiTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)));
+      size_t i = 0;
+
+      for (; i + 32 <= n; i += 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = classify_avx2(block, loTable, hiTable);
+        if (Not)
+          mask = ~mask;
+        if (mask != 0)
+          return i + __builtin_ctz(mask);
+      }
+
+      size_t tail = find_class_ssse3<Not>(data + i, n - i, lo, hi);
+      return tail == not_found ? not_found : i + tail;
+    }
+
+    template <bool Not>
+    __attribute__((target("avx2"))) size_t rfind_class_avx2(const char* data, size_t n, const unsigned char* lo, const unsigned char* hi)
+    {
+      const __m256i loTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo)));
+      const __m256i hiTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)));
+      size_t i = n;
+
+      for (; i >= 32; i -= 32)
+      {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 32));
+        unsigned mask = classify_avx2(block, loTable, hiTable);
+        if (Not)
+          mask = ~mask;
+        if (mask != 0)
+          return i - 32 + (31 - __builtin_clz(mask));
+      }
+
+      return rfind_class_ssse3<Not>(data, i, lo, hi);
+    }
+
+    void hash_accumulate_sse2(uint64_t* acc, const char* data, size_t stripes, const uint64_t* secret)
+    {
+      __m128i lanes[4];
+      for (size_t j = 0; j < 4; j++)
+        lanes[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + j * 2));
+
+      for (size_t s = 0; s < stripes; s++)
+      {
+        for (size_t j = 0; j < 4; j++)
+        {
+          __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + s * 64 + j * 16));
+          __m128i k = _mm_xor_si128(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + s + j * 2)));
+          // lo32(k) * hi32(k) in each 64-bit lane, plus d with its two words swapped
+          __m128i product = _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+          __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+          lanes[j] = _mm_add_epi64(lanes[j], _mm_add_epi64(product, swapped));
+        }
+      }
+
+      for (size_t j = 0; j < 4; j++)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + j * 2), lanes[j]);
+    }
+
+    __attribute__((target("avx2"))) void hash_accumulate_avx2(uint64_t* acc, const char* data, size_t stripes, const uint64_t* secret)
+    {
+      __m256i lanes[2];
+      for (size_t j = 0; j < 2; j++)
+        lanes[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + j * 4));
+
+      for (size_t s = 0; s < stripes; s++)
+      {
+        for (size_t j = 0; j < 2; j++)
+        {
+          __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + s * 64 + j * 32));
+          __m256i k = _mm256_xor_si256(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + s + j * 4)));
+          __m256i product = _mm256_mul_epu32(k, _mm256_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+          __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+          lanes[j] = _mm256_add_epi64(lanes[j], _mm256_add_epi64(product, swapped));
+        }
+      }
+
+      for (size_t j = 0; j < 2; j++)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j * 4), lanes[j]);
+    }
+#endif
+
+    /**
+     * @brief Sceglie i kernel migliori supportati dalla CPU (AVX2, SSE2 o scalari).
+     *
+     * @return I kernel selezionati.
+     */
+    char_search_kernels select_char_search()
+    {
+#ifdef ZKL_SIMD_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return {find_char_avx2<false>, rfind_char_avx2<false>, find_char_avx2<true>, rfind_char_avx2<true>};
+      return {find_char_sse2<false>, rfind_char_sse2<false>, find_char_sse2<true>, rfind_char_sse2<true>};
+#else
+      return {find_char_scalar<false>, rfind_char_scalar<false>, find_char_scalar<true>, rfind_char_scalar<true>};
+#endif
+    }
+
+    /**
+     * @brief Restituisce i kernel di ricerca, selezionati una sola volta al primo utilizzo.
+     *
+     * @return Riferimento costante ai kernel selezionati.
+     */
+    const char_search_kernels& char_search()
+    {
+      static const char_search_kernels kernels = select_char_search();
+      return kernels;
+    }
+
+    /**
+     * @brief Sceglie i kernel per classe migliori supportati dalla CPU (AVX2, SSSE3 o scalari).
+     *
+     * @return I kernel selezionati.
+     */
+    class_search_kernels select_class_search()
+    {
+#ifdef ZKL_SIMD_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return {find_class_avx2<false>, rfind_class_avx2<false>, find_class_avx2<true>, rfind_class_avx2<true>};
+      if (__builtin_cpu_supports("ssse3"))
+        return {find_class_ssse3<false>, rfind_class_ssse3<false>, find_class_ssse3<true>, rfind_class_ssse3<true>};
+#endif
+      return {find_class_scalar<false>, rfind_class_scalar<false>, find_class_scalar<true>, rfind_class_scalar<true>};
+    }
+
+    /**
+     * @brief Restituisce i kernel di ricerca per classe, selezionati una sola volta al primo utilizzo.
+     *
+     * @return Riferimento costante ai kernel selezionati.
+     */
+    const class_search_kernels& class_search()
+    {
+      static const class_search_kernels kernels = select_class_search();
+      return kernels;
+    }
+
+    /**
+     * @brief Sceglie il kernel di accumulo dell'hash migliore supportato dalla CPU (AVX2, SSE2 o scalare).
+     *
+     * @return Il kernel selezionato.
+     */
+    hash_accumulate_fn select_hash_accumulate()
+    {
+#ifdef ZKL_SIMD_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return hash_accumulate_avx2;
+      return hash_accumulate_sse2;
+#else
+      return hash_accumulate_scalar;
+#endif
+    }
+
+    /**
+     * @brief Restituisce il kernel di accumulo dell'hash, selezionato una sola volta al primo utilizzo.
+     *
+     * @return Il kernel selezionato.
+     */
+    hash_accumulate_fn hash_accumulate()
+    {
+      static const hash_accumulate_fn kernel = select_hash_accumulate();
+      return kernel;
+    }
+  } // namespace detail
+} // namespace zkl
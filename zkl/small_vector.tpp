@@ -0,0 +1,526 @@
+#pragma once
+
+#include "zkl.hpp"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace zkl
+{
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  T* small_vector<T, N, GrowthPolicy, Allocator>::inline_data() noexcept
+  {
+    return reinterpret_cast<T*>(_inline);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  bool small_vector<T, N, GrowthPolicy, Allocator>::is_inline() const noexcept
+  {
+    return _array == reinterpret_cast<const T*>(_inline);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  T* small_vector<T, N, GrowthPolicy, Allocator>::allocate(size_t count)
+  {
+    if (count > alloc_traits::max_size(_allocator))
+    {
+      throw std::length_error("Vector too long");
+    }
+
+    T* array = alloc_traits::allocate(_allocator, count);
+    detail::stats_allocated(stats::container::small_vector, count * sizeof(T));
+    return array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::deallocate(T* array, size_t count) noexcept
+  {
+    if (array != inline_data())
+    {
+      alloc_traits::deallocate(_allocator, array, count);
+      detail::stats_freed(stats::container::small_vector, count * sizeof(T));
+    }
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::destroy(T* array, size_t count) noexcept
+  {
+    if (std::is_trivially_destructible<T>::value)
+      return;
+
+    for (size_t i = 0; i < count; i++)
+      alloc_traits::destroy(_allocator, array + i);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::relocate(T* from, size_t count, T* to)
+  {
+    if (count == 0)
+      return;
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+      std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+      return;
+    }
+
+    size_t constructed = 0;
+    try
+    {
+      for (; constructed < count; constructed++)
+        alloc_traits::construct(_allocator, to + constructed, std::move_if_noexcept(from[constructed]));
+    }
+    catch (...)
+    {
+      destroy(to, constructed);
+      throw;
+    }
+
+    destroy(from, count);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::steal(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    destroy(_array, _size);
+    deallocate(_array, _capacity);
+    _array = inline_data();
+    _size = 0;
+    _capacity = N;
+
+    if (other.is_inline())
+    {
+      // inline elements cannot change owner, they have to move into our buffer
+      relocate(other._array, other._size, _array);
+      _size = other._size;
+    }
+    else
+    {
+      _array = other._array;
+      _size = other._size;
+      _capacity = other._capacity;
+    }
+
+    other._array = other.inline_data();
+    other._size = 0;
+    other._capacity = N;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector()
+      : _array(inline_data()), _size(0), _capacity(N), _allocator()
+  {
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const Allocator& allocator)
+      : _array(inline_data()), _size(0), _capacity(N), _allocator(allocator)
+  {
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector(size_t initialCapacity, const Allocator& allocator)
+      : _array(inline_data()), _size(0), _capacity(N), _allocator(allocator)
+  {
+    if (initialCapacity > N)
+    {
+      _array = allocate(initialCapacity);
+      _capacity = initialCapacity;
+    }
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const small_vector& other)
+      : small_vector(other, alloc_traits::select_on_container_copy_construction(other._allocator))
+  {
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector(const small_vector& other, const Allocator& allocator)
+      : small_vector(other._size, allocator)
+  {
+    // the delegated constructor has finished, so a throwing copy is cleaned up by the destructor
+    for (; _size < other._size; _size++)
+      alloc_traits::construct(_allocator, _array + _size, other._array[_size]);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      : _array(inline_data()), _size(0), _capacity(N), _allocator(std::move(other._allocator))
+  {
+    steal(other);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>::~small_vector()
+  {
+    destroy(_array, _size);
+    deallocate(_array, _capacity);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>& small_vector<T, N, GrowthPolicy, Allocator>::operator=(const small_vector& other)
+  {
+    if (this == &other)
+      return *this;
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+      // memory from the old allocator must go back to it before the allocator is replaced
+      if (_allocator != other._allocator)
+      {
+        small_vector empty(_allocator);
+        steal(empty);
+      }
+      _allocator = other._allocator;
+    }
+
+    small_vector copy(other, _allocator);
+    steal(copy);
+    return *this;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  small_vector<T, N, GrowthPolicy, Allocator>& small_vector<T, N, GrowthPolicy, Allocator>::operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+  {
+    if (this == &other)
+      return *this;
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    {
+      small_vector empty(_allocator);
+      steal(empty);
+      _allocator = std::move(other._allocator);
+      steal(other);
+    }
+    else
+    {
+      if (_allocator == other._allocator)
+      {
+        steal(other);
+        return *this;
+      }
+
+      // different memory resources: the elements have to move into memory from our allocator
+      small_vector moved(_allocator);
+      moved.reserve(other._size);
+      for (size_t i = 0; i < other._size; i++)
+        moved.emplace_back(std::move(other._array[i]));
+      steal(moved);
+      other.clear();
+    }
+
+    return *this;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  Allocator small_vector<T, N, GrowthPolicy, Allocator>::get_allocator() const
+  {
+    return _allocator;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::reallocate(size_t newCapacity)
+  {
+    if (newCapacity <= N)
+    {
+      if (is_inline())
+        return;
+
+      // back into the inline buffer; the heap array is freed only once the elements are out
+      relocate(_array, _size, inline_data());
+      detail::stats_reallocated(stats::container::small_vector, _size * sizeof(T));
+      deallocate(_array, _capacity);
+
+      _array = inline_data();
+      _capacity = N;
+      return;
+    }
+
+    T* newArray = allocate(newCapacity);
+
+    try
+    {
+      relocate(_array, _size, newArray);
+    }
+    catch (...)
+    {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    detail::stats_reallocated(stats::container::small_vector, _size * sizeof(T));
+    deallocate(_array, _capacity);
+
+    _array = newArray;
+    _capacity = newCapacity;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::push_back(const T& value)
+  {
+    emplace_back(value);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::push_back(T&& value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  template <typename... Args>
+  T& small_vector<T, N, GrowthPolicy, Allocator>::emplace_back(Args&&... args)
+  {
+    if (_size < _capacity)
+    {
+      alloc_traits::construct(_allocator, _array + _size, std::forward<Args>(args)...);
+      return _array[_size++];
+    }
+
+    // the new element is built before the old ones move, because args may refer to them
+    size_t newCapacity = GrowthPolicy::grow(_capacity, _size + 1);
+    T* newArray = allocate(newCapacity);
+
+    try
+    {
+      alloc_traits::construct(_allocator, newArray + _size, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    try
+    {
+      relocate(_array, _size, newArray);
+    }
+    catch (...)
+    {
+      alloc_traits::destroy(_allocator, newArray + _size);
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    detail::stats_reallocated(stats::container::small_vector, _size * sizeof(T));
+    deallocate(_array, _capacity);
+    _array = newArray;
+    _capacity = newCapacity;
+
+    return _array[_size++];
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::pop_back()
+  {
+    if (_size == 0)
+    {
+      throw std::out_of_range("Vector is empty");
+    }
+    _size--;
+    alloc_traits::destroy(_allocator, _array + _size);
+
+    if (is_inline())
+      return;
+
+    size_t newCapacity = GrowthPolicy::shrink(_size, _capacity);
+    if (newCapacity < _capacity)
+      reallocate(newCapacity);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  T& small_vector<T, N, GrowthPolicy, Allocator>::at(size_t index)
+  {
+    if (index >= _size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+
+    return _array[index];
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  const T& small_vector<T, N, GrowthPolicy, Allocator>::at(size_t index) const
+  {
+    if (index >= _size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+
+    return _array[index];
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  T& small_vector<T, N, GrowthPolicy, Allocator>::operator[](size_t index)
+  {
+    return _array[index];
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  const T& small_vector<T, N, GrowthPolicy, Allocator>::operator[](size_t index) const
+  {
+    return _array[index];
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  T* small_vector<T, N, GrowthPolicy, Allocator>::data() noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  const T* small_vector<T, N, GrowthPolicy, Allocator>::data() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::iterator small_vector<T, N, GrowthPolicy, Allocator>::begin() noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::const_iterator small_vector<T, N, GrowthPolicy, Allocator>::begin() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::const_iterator small_vector<T, N, GrowthPolicy, Allocator>::cbegin() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::iterator small_vector<T, N, GrowthPolicy, Allocator>::end() noexcept
+  {
+    return _array + _size;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::const_iterator small_vector<T, N, GrowthPolicy, Allocator>::end() const noexcept
+  {
+    return _array + _size;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  typename small_vector<T, N, GrowthPolicy, Allocator>::const_iterator small_vector<T, N, GrowthPolicy, Allocator>::cend() const noexcept
+  {
+    return _array + _size;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  size_t small_vector<T, N, GrowthPolicy, Allocator>::size() const
+  {
+    return _size;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  size_t small_vector<T, N, GrowthPolicy, Allocator>::capacity() const
+  {
+    return _capacity;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  bool small_vector<T, N, GrowthPolicy, Allocator>::empty() const
+  {
+    return _size == 0;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::clear() noexcept
+  {
+    destroy(_array, _size);
+    _size = 0;
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::reserve(size_t newCapacity)
+  {
+    if (_capacity >= newCapacity)
+      return;
+    reallocate(newCapacity);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::shrink_to_fit()
+  {
+    if (!is_inline() && _capacity > _size)
+      reallocate(_size);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::resize(size_t newSize)
+  {
+    if (newSize < _size)
+    {
+      destroy(_array + newSize, _size - newSize);
+      _size = newSize;
+      return;
+    }
+
+    if (newSize > _capacity)
+      reallocate(newSize);
+
+    for (; _size < newSize; _size++)
+      alloc_traits::construct(_allocator, _array + _size);
+  }
+
+  template <typename T, size_t N, typename GrowthPolicy, typename Allocator>
+  void small_vector<T, N, GrowthPolicy, Allocator>::swap(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_swappable<T>::value)
+  {
+    if (this == &other)
+      return;
+
+    // like std::vector, non-propagating allocators are expected to compare equal
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+      using std::swap;
+      swap(_allocator, other._allocator);
+    }
+
+    if (!is_inline() && !other.is_inline())
+    {
+      T* array = _array;
+      _array = other._array;
+      other._array = array;
+
+      size_t capacity = _capacity;
+      _capacity = other._capacity;
+      other._capacity = capacity;
+    }
+    else if (is_inline() && other.is_inline())
+    {
+      // swap the common prefix in place, then move the longer tail across
+      small_vector& shorter = _size <= other._size ? *this : other;
+      small_vector& longer = _size <= other._size ? other : *this;
+
+      using std::swap;
+      for (size_t i = 0; i < shorter._size; i++)
+        swap(shorter._array[i], longer._array[i]);
+
+      relocate(longer._array + shorter._size, longer._size - shorter._size, shorter._array + shorter._size);
+    }
+    else
+    {
+      // the inline elements move into the other buffer before the heap array changes owner
+      small_vector& local = is_inline() ? *this : other;
+      small_vector& heap = is_inline() ? other : *this;
+
+      relocate(local._array, local._size, heap.inline_data());
+
+      local._array = heap._array;
+      local._capacity = heap._capacity;
+      heap._array = heap.inline_data();
+      heap._capacity = N;
+    }
+
+    size_t size = _size;
+    _size = other._size;
+    other._size = size;
+  }
+} // namespace zkl
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "simd.tpp"
+#include "zkl.hpp"
+
+namespace zkl
+{
+  namespace detail
+  {
+    size_t char_delimiter::find(const char* data, size_t n) const noexcept
+    {
+      return char_search().find(data, n, c);
+    }
+
+    size_t char_delimiter::size() const noexcept
+    {
+      return 1;
+    }
+
+    size_t string_delimiter::find(const char* data, size_t n) const noexcept
+    {
+      if (pattern.empty())
+        return not_found;
+      return search_forward(data, n, 0, pattern.data(), pattern.size(), nullptr);
+    }
+
+    size_t string_delimiter::size() const noexcept
+    {
+      return pattern.size();
+    }
+
+    size_t set_delimiter::find(const char* data, size_t n) const noexcept
+    {
+      size_t i = string_view(data, n).find_first_of(set);
+      return i == string_view::npos ? not_found : i;
+    }
+
+    size_t set_delimiter::size() const noexcept
+    {
+      return 1;
+    }
+  } // namespace detail
+
+  template <typename Delimiter>
+  split_range<Delimiter>::iterator::iterator() noexcept : _range(nullptr), _field(), _next(nullptr), _last(true)
+  {
+  }
+
+  template <typename Delimiter>
+  split_range<Delimiter>::iterator::iterator(const split_range* range) noexcept
+      : _range(range), _field(), _next(range->_text.data()), _last(false)
+  {
+    advance();
+  }
+
+  template <typename Delimiter>
+  void split_range<Delimiter>::iterator::advance() noexcept
+  {
+    const char* end = _range->_text.data() + _range->_text.size();
+
+    for (;;)
+    {
+      if (_last)
+      {
+        _range = nullptr;
+        _field = string_view();
+        return;
+      }
+
+      size_t remaining = static_cast<size_t>(end - _next);
+      size_t found = _range->_delimiter.find(_next, remaining);
+
+      if (found == detail::not_found)
+      {
+        _field = string_view(_next, remaining);
+        _next = end;
+        _last = true;
+      }
+      else
+      {
+        _field = string_view(_next, found);
+        _next += found + _range->_delimiter.size();
+      }
+
+      if (!_field.empty() || _range->_empty == empty_fields::keep)
+        return;
+    }
+  }
+
+  template <typename Delimiter>
+  const string_view& split_range<Delimiter>::iterator::operator*() const noexcept
+  {
+    return _field;
+  }
+
+  template <typename Delimiter>
+  const string_view* split_range<Delimiter>::iterator::operator->() const noexcept
+  {
+    return &_field;
+  }
+
+  template <typename Delimiter>
+  typename split_range<Delimiter>::iterator& split_range<Delimiter>::iterator::operator++() noexcept
+  {
+    advance();
+    return *this;
+  }
+
+  template <typename Delimiter>
+  typename split_range<Delimiter>::iterator split_range<Delimiter>::iterator::operator++(int) noexcept
+  {
+    iterator previous = *this;
+    advance();
+    return previous;
+  }
+
+  template <typename Delimiter>
+  bool split_range<Delimiter>::iterator::operator==(const iterator& other) const noexcept
+  {
+    // _next alone is not enough: a trailing empty field starts where the one before it ended
+    if (_range == nullptr || other._range == nullptr)
+      return _range == other._range;
+    return _next == other._next && _last == other._last;
+  }
+
+  template <typename Delimiter>
+  bool split_range<Delimiter>::iterator::operator!=(const iterator& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+  template <typename Delimiter>
+  split_range<Delimiter>::split_range(string_view text, const Delimiter& delimiter, empty_fields empty) noexcept
+      : _text(text), _delimiter(delimiter), _empty(empty)
+  {
+  }
+
+  template <typename Delimiter>
+  typename split_range<Delimiter>::iterator split_range<Delimiter>::begin() const noexcept
+  {
+    return iterator(this);
+  }
+
+  template <typename Delimiter>
+  typename split_range<Delimiter>::iterator split_range<Delimiter>::end() const noexcept
+  {
+    return iterator();
+  }
+
+  split_range<detail::char_delimiter> split(string_view text, char delim, empty_fields empty) noexcept
+  {
+    return split_range<detail::char_delimiter>(text, detail::char_delimiter{delim}, empty);
+  }
+
+  split_range<detail::string_delimiter> split(string_view text, string_view delim, empty_fields empty) noexcept
+  {
+    return split_range<detail::string_delimiter>(text, detail::string_delimiter{delim}, empty);
+  }
+
+  split_range<detail::set_delimiter> split(string_view text, const char_set& delim, empty_fields empty) noexcept
+  {
+    return split_range<detail::set_delimiter>(text, detail::set_delimiter{delim}, empty);
+  }
+
+  split_range<detail::char_delimiter> string::split(char delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+
+  split_range<detail::string_delimiter> string::split(string_view delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+
+  split_range<detail::set_delimiter> string::split(const char_set& delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+
+  split_range<detail::char_delimiter> string_view::split(char delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+
+  split_range<detail::string_delimiter> string_view::split(string_view delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+
+  split_range<detail::set_delimiter> string_view::split(const char_set& delim, empty_fields empty) const noexcept
+  {
+    return zkl::split(*this, delim, empty);
+  }
+} // namespace zkl
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "zkl.hpp"
+
+namespace zkl
+{
+#ifdef ZKL_STATS
+  namespace detail
+  {
+    /**
+     * @brief I contatori atomici di un contenitore, su una linea di cache propria.
+     */
+    struct alignas(64) stats_cell
+    {
+      std::atomic<uint64_t> allocations;
+      std::atomic<uint64_t> frees;
+      std::atomic<uint64_t> bytesAllocated;
+      std::atomic<uint64_t> reallocations;
+      std::atomic<uint64_t> bytesCopied;
+      std::atomic<uint64_t> liveBytes;
+      std::atomic<uint64_t> peakLiveBytes;
+    };
+
+    stats_cell& stats_of(stats::container c) noexcept
+    {
+      static stats_cell cells[3] = {};
+      return cells[static_cast<size_t>(c)];
+    }
+
+    void stats_raise_peak(stats_cell& cell, uint64_t live) noexcept
+    {
+      uint64_t peak = cell.peakLiveBytes.load(std::memory_order_relaxed);
+      while (peak < live && !cell.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    void stats_allocated(stats::container c, size_t bytes) noexcept
+    {
+      stats_cell& cell = stats_of(c);
+      cell.allocations.fetch_add(1, std::memory_order_relaxed);
+      cell.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+      stats_raise_peak(cell, cell.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+
+    void stats_freed(stats::container c, size_t bytes) noexcept
+    {
+      stats_cell& cell = stats_of(c);
+      cell.frees.fetch_add(1, std::memory_order_relaxed);
+      cell.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void stats_reallocated(stats::container c, size_t bytes) noexcept
+    {
+      stats_cell& cell = stats_of(c);
+      cell.reallocations.fetch_add(1, std::memory_order_relaxed);
+      cell.bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    stats::counters stats_load(stats::container c) noexcept
+    {
+      stats_cell& cell = stats_of(c);
+      stats::counters counters;
+      counters.allocations = cell.allocations.load(std::memory_order_relaxed);
+      counters.frees = cell.frees.load(std::memory_order_relaxed);
+      counters.bytesAllocated = cell.bytesAllocated.load(std::memory_order_relaxed);
+      counters.reallocations = cell.reallocations.load(std::memory_order_relaxed);
+      counters.bytesCopied = cell.bytesCopied.load(std::memory_order_relaxed);
+      counters.liveBytes = cell.liveBytes.load(std::memory_order_relaxed);
+      counters.peakLiveBytes = cell.peakLiveBytes.load(std::memory_order_relaxed);
+      return counters;
+    }
+  } // namespace detail
+#endif
+
+  namespace detail
+  {
+    stats::counters stats_since(stats::counters now, const stats::counters& start) noexcept
+    {
+      // live and peak bytes are levels, not totals, so they stay as they are
+      now.allocations -= start.allocations;
+      now.frees -= start.frees;
+      now.bytesAllocated -= start.bytesAllocated;
+      now.reallocations -= start.reallocations;
+      now.bytesCopied -= start.bytesCopied;
+      return now;
+    }
+  } // namespace detail
+
+  namespace stats
+  {
+    const counters& report::operator[](container c) const noexcept
+    {
+      switch (c)
+      {
+      case container::string:
+        return strings;
+      case container::vector:
+        return vectors;
+      default:
+        return smallVectors;
+      }
+    }
+
+    report snapshot() noexcept
+    {
+      report current;
+#ifdef ZKL_STATS
+      current.strings = detail::stats_load(container::string);
+      current.vectors = detail::stats_load(container::vector);
+      current.smallVectors = detail::stats_load(container::small_vector);
+#endif
+      return current;
+    }
+
+    void reset() noexcept
+    {
+#ifdef ZKL_STATS
+      for (container c : {container::string, container::vector, container::small_vector})
+      {
+        detail::stats_cell& cell = detail::stats_of(c);
+        cell.allocations.store(0, std::memory_order_relaxed);
+        cell.frees.store(0, std::memory_order_relaxed);
+        cell.bytesAllocated.store(0, std::memory_order_relaxed);
+        cell.reallocations.store(0, std::memory_order_relaxed);
+        cell.bytesCopied.store(0, std::memory_order_relaxed);
+        cell.peakLiveBytes.store(cell.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+#endif
+    }
+
+    scope::scope() noexcept : _start(snapshot())
+    {
+#ifdef ZKL_STATS
+      // the peak restarts from the current live bytes, so it only reflects this region
+      for (container c : {container::string, container::vector, container::small_vector})
+        detail::stats_of(c).peakLiveBytes.store(_start[c].liveBytes, std::memory_order_relaxed);
+#endif
+    }
+
+    scope::~scope()
+    {
+#ifdef ZKL_STATS
+      for (container c : {container::string, container::vector, container::small_vector})
+        detail::stats_raise_peak(detail::stats_of(c), _start[c].peakLiveBytes);
+#endif
+    }
+
+    report scope::delta() const noexcept
+    {
+      report now = snapshot();
+      now.strings = detail::stats_since(now.strings, _start.strings);
+      now.vectors = detail::stats_since(now.vectors, _start.vectors);
+      now.smallVectors = detail::stats_since(now.smallVectors, _start.smallVectors);
+      return now;
+    }
+  } // namespace stats
+} // namespace zkl
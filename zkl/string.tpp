@@ -1,52 +1,77 @@
 #pragma once
 
+#include "simd.tpp"
 #include "zkl.hpp"
 #include <cctype>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 
 namespace zkl
 {
-  string::string() : _data(nullptr), _size(0)
+  string::string() : _data(_local), _size(0)
   {
+    _local[0] = 0;
   }
 
-  string::string(const char* string)
+  string::string(const char* string) : _data(_local), _size(0)
   {
-    _size = std::strlen(string);
-    _data = new char[_size + 1];
-    std::strcpy(_data, string);
+    init(string, std::strlen(string));
   }
 
-  string::string(const string& other)
+  string::string(const string& other) : _data(_local), _size(0)
   {
-    _size = other._size;
-    _data = new char[_size + 1];
-    std::strcpy(_data, other._data);
+    init(other._data, other._size);
+  }
+
+  string::string(string_view sv) : _data(_local), _size(0)
+  {
+    init(sv.data(), sv.size());
   }
 
   string::string(string&& other) noexcept
   {
     _size = other._size;
-    _data = other._data;
 
-    other._data = nullptr;
+    if (other.is_local())
+    {
+      // short strings live inside the object, so there is nothing to steal
+      _data = _local;
+      std::memcpy(_local, other._local, sizeof(_local));
+    }
+    else
+    {
+      _data = other._data;
+      _capacity = other._capacity;
+    }
+
+    other._data = other._local;
+    other._size = 0;
+    other._local[0] = 0;
   }
 
   string::~string()
   {
-    delete[] _data;
+    if (!is_local())
+      deallocate(_data, _capacity);
   }
 
   string& string::operator=(const string& other)
   {
     if (this != &other)
     {
-      delete[] _data;
+      // reuse the current buffer whenever it is big enough
+      if (capacity() < other._size)
+      {
+        char* newData = allocate(other._size);
+        if (!is_local())
+          deallocate(_data, _capacity);
+        _data = newData;
+        _capacity = other._size;
+      }
 
       _size = other._size;
-      _data = new char[_size + 1];
-      std::strcpy(_data, other._data);
+      std::memcpy(_data, other._data, _size + 1);
     }
 
     return *this;
@@ -56,125 +81,359 @@ namespace zkl
   {
     if (this != &other)
     {
-      delete[] _data;
+      if (!is_local())
+        deallocate(_data, _capacity);
 
       _size = other._size;
-      _data = other._data;
 
-      other._data = nullptr;
+      if (other.is_local())
+      {
+        _data = _local;
+        std::memcpy(_local, other._local, sizeof(_local));
+      }
+      else
+      {
+        _data = other._data;
+        _capacity = other._capacity;
+      }
+
+      other._data = other._local;
+      other._size = 0;
+      other._local[0] = 0;
     }
 
     return *this;
   }
 
-  std::istream& operator>>(std::istream& is, string& str)
+  namespace detail
   {
+    /**
+     * @brief Accesso all'area di lettura (protetta) di uno std::streambuf.
+     *
+     * I puntatori a membro ottenuti tramite una classe derivata possono essere usati
+     * su qualsiasi std::streambuf, permettendo di leggere il buffer a blocchi senza
+     * una chiamata virtuale per ogni carattere.
+     */
+    struct streambuf_access : std::streambuf
+    {
+      static char* begin(std::streambuf* sb)
+      {
+        return (sb->*&streambuf_access::gptr)();
+      }
+
+      static char* end(std::streambuf* sb)
+      {
+        char* begin = (sb->*&streambuf_access::gptr)();
+        char* end = (sb->*&streambuf_access::egptr)();
+
+        // gbump only takes an int
+        if (end - begin > std::numeric_limits<int>::max())
+          end = begin + std::numeric_limits<int>::max();
+        return end;
+      }
+
+      static void bump(std::streambuf* sb, size_t n)
+      {
+        (sb->*&streambuf_access::gbump)(static_cast<int>(n));
+      }
+    };
+
+    /**
+     * @brief Trova il primo carattere di spaziatura.
+     */
+    struct space_finder
+    {
+      const char* operator()(const char* begin, const char* end) const
+      {
+        while (begin != end && !std::isspace(static_cast<unsigned char>(*begin)))
+          begin++;
+        return begin;
+      }
+    };
+
+    /**
+     * @brief Trova il primo '\n' o '\r'.
+     */
+    struct newline_finder
+    {
+      const char* operator()(const char* begin, const char* end) const
+      {
+        const char* nl = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        if (nl == nullptr)
+          nl = end;
+        const char* cr = static_cast<const char*>(std::memchr(begin, '\r', nl - begin));
+        return cr != nullptr ? cr : nl;
+      }
+    };
+
+    /**
+     * @brief Trova la prima occorrenza di un carattere delimitatore.
+     */
+    struct char_finder
+    {
+      char delim;
+
+      const char* operator()(const char* begin, const char* end) const
+      {
+        const char* found = static_cast<const char*>(std::memchr(begin, delim, end - begin));
+        return found != nullptr ? found : end;
+      }
+    };
+  } // namespace detail
+
+  template <typename Finder>
+  std::istream& string::extract(std::istream& is, string& str, Finder find)
+  {
+    typedef std::char_traits<char> traits;
+
     str.clear();
-    int c;
+
+    std::istream::sentry ok(is, true);
+    if (!ok)
+      return is;
+
+    std::streambuf* sb = is.rdbuf();
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    bool delimFound = false;
 
     // skip leading whitespace
-    while (c = is.get())
+    while (true)
     {
-      if (!std::isspace(c))
+      int c = sb->sgetc();
+      if (traits::eq_int_type(c, traits::eof()))
       {
-        str.push_back(c);
+        state |= std::ios_base::eofbit;
         break;
       }
-    }
 
-    if (is.eof())
-      return is;
+      char* begin = detail::streambuf_access::begin(sb);
+      char* end = detail::streambuf_access::end(sb);
+      if (begin == end) // unbuffered stream, go one char at a time
+      {
+        if (!std::isspace(c))
+          break;
+        sb->sbumpc();
+        continue;
+      }
 
-    // read until newline
-    while (c = is.get())
+      char* p = begin;
+      while (p != end && std::isspace(static_cast<unsigned char>(*p)))
+        p++;
+      detail::streambuf_access::bump(sb, p - begin);
+
+      if (p != end)
+        break;
+    }
+
+    // read whole chunks of the get area until the delimiter
+    while (!(state & std::ios_base::eofbit))
     {
-      if (std::isspace(c))
+      int c = sb->sgetc();
+      if (traits::eq_int_type(c, traits::eof()))
+      {
+        state |= std::ios_base::eofbit;
         break;
-      str.push_back(c);
+      }
+
+      char* begin = detail::streambuf_access::begin(sb);
+      char* end = detail::streambuf_access::end(sb);
+      if (begin == end) // unbuffered stream, go one char at a time
+      {
+        char ch = traits::to_char_type(sb->sbumpc());
+        if (find(&ch, &ch + 1) != &ch + 1)
+        {
+          delimFound = true;
+          break;
+        }
+        str.append_raw(&ch, 1);
+        continue;
+      }
+
+      const char* delim = find(begin, end);
+      str.append_raw(begin, delim - begin);
+
+      if (delim != end)
+      {
+        detail::streambuf_access::bump(sb, delim - begin + 1); // consume the delimiter too
+        delimFound = true;
+        break;
+      }
+
+      detail::streambuf_access::bump(sb, end - begin);
     }
 
+    if (str._size == 0 && !delimFound)
+      state |= std::ios_base::failbit;
+
+    is.setstate(state);
     return is;
   }
 
+  std::istream& operator>>(std::istream& is, string& str)
+  {
+    // read until whitespace
+    return string::extract(is, str, detail::space_finder());
+  }
+
   std::ostream& operator<<(std::ostream& os, const string& other)
   {
-    os << (other._data != nullptr ? other._data : "");
+    os << other._data;
     return os;
   }
 
   std::istream& getline(std::istream& is, string& str)
   {
-    str.clear();
-    int c;
+    // read until newline
+    return string::extract(is, str, detail::newline_finder());
+  }
 
-    // skip leading whitespace
-    while (c = is.get())
-    {
-      if (!std::isspace(c))
-      {
-        str.push_back(c);
-        break;
-      }
-    }
+  std::istream& getline(std::istream& is, string& str, char delim)
+  {
+    // read until delim
+    detail::char_finder finder = {delim};
+    return string::extract(is, str, finder);
+  }
 
-    if (is.eof())
-      return is;
+  size_t string::size() const
+  {
+    return _size;
+  }
 
-    // read until newline
-    while (c = is.get())
-    {
-      if (c == '\n' || c == '\r')
-        break;
-      str.push_back(c);
-    }
+  size_t string::length() const
+  {
+    return _size;
+  }
 
-    return is;
+  size_t string::capacity() const
+  {
+    return is_local() ? _localCapacity : _capacity;
   }
 
-  std::istream& getline(std::istream& is, string& str, char delim)
+  void string::reserve(size_t newCapacity)
   {
-    str.clear();
-    int c;
+    if (capacity() >= newCapacity)
+      return;
+    reallocate(newCapacity);
+  }
 
-    // skip leading whitespace
-    while (c = is.get())
+  void string::shrink_to_fit()
+  {
+    if (is_local() || _capacity == _size)
+      return;
+    reallocate(_size);
+  }
+
+  bool string::is_local() const
+  {
+    return _data == _local;
+  }
+
+  char* string::allocate(size_t capacity)
+  {
+    char* data = new char[capacity + 1];
+    detail::stats_allocated(stats::container::string, capacity + 1);
+    return data;
+  }
+
+  void string::deallocate(char* data, size_t capacity) noexcept
+  {
+    delete[] data;
+    detail::stats_freed(stats::container::string, capacity + 1);
+  }
+
+  void string::init(const char* str, size_t n)
+  {
+    if (n > _localCapacity)
     {
-      if (!std::isspace(c))
-      {
-        str.push_back(c);
-        break;
-      }
+      _data = allocate(n);
+      _capacity = n;
     }
 
-    if (is.eof())
-      return is;
+    std::memcpy(_data, str, n);
+    _size = n;
+    _data[_size] = 0;
+  }
 
-    // read until delim
-    while (c = is.get())
+  void string::reallocate(size_t newCapacity)
+  {
+    if (newCapacity <= _localCapacity)
     {
-      if (c == delim)
-        break;
-      str.push_back(c);
+      // fits in the inline buffer again, only reached from shrink_to_fit
+      if (is_local())
+        return;
+
+      char* oldData = _data;
+      size_t oldCapacity = _capacity;
+      std::memcpy(_local, oldData, _size + 1);
+      deallocate(oldData, oldCapacity);
+      detail::stats_reallocated(stats::container::string, _size + 1);
+      _data = _local;
+      return;
     }
 
-    return is;
+    char* newData = allocate(newCapacity);
+    std::memcpy(newData, _data, _size + 1);
+    detail::stats_reallocated(stats::container::string, _size + 1);
+
+    if (!is_local())
+      deallocate(_data, _capacity);
+
+    _data = newData;
+    _capacity = newCapacity;
   }
 
-  size_t string::size() const
+  void string::grow(size_t minCapacity)
   {
-    return _size;
+    size_t oldCapacity = capacity();
+    if (oldCapacity >= minCapacity)
+      return;
+
+    size_t newCapacity = oldCapacity * 2;
+    if (newCapacity < minCapacity)
+      newCapacity = minCapacity;
+
+    reallocate(newCapacity);
   }
 
-  size_t string::length() const
+  string& string::append_raw(const char* str, size_t n)
   {
-    return _size;
+    if (n == 0)
+      return *this;
+
+    size_t oldCapacity = capacity();
+    if (_size + n > oldCapacity)
+    {
+      // str may point inside our own buffer (e.g. s += s), so it has to be
+      // copied over before the old buffer gets released
+      size_t newCapacity = oldCapacity * 2;
+      if (newCapacity < _size + n)
+        newCapacity = _size + n;
+
+      char* newData = allocate(newCapacity);
+      std::memcpy(newData, _data, _size);
+      std::memcpy(newData + _size, str, n);
+      detail::stats_reallocated(stats::container::string, _size);
+
+      if (!is_local())
+        deallocate(_data, _capacity);
+
+      _data = newData;
+      _capacity = newCapacity;
+    }
+    else
+    {
+      std::memmove(_data + _size, str, n);
+    }
+
+    _size += n;
+    _data[_size] = 0;
+    return *this;
   }
 
   void string::clear()
   {
     _size = 0;
-    delete[] _data;
-    _data = nullptr;
+    _data[0] = 0;
   }
 
   bool string::empty() const
@@ -234,71 +493,121 @@ namespace zkl
 
   string& string::operator+=(const string& other)
   {
-    string temp;
-    temp._size = _size + other._size;
-    temp._data = new char[temp._size + 1];
+    return append_raw(other._data, other._size);
+  }
 
-    memcpy(temp._data, _data, _size);
-    memcpy(temp._data + _size, other._data, other._size);
-    temp._data[temp._size] = 0;
+  string& string::operator+=(const char* str)
+  {
+    return append_raw(str, std::strlen(str));
+  }
 
-    *this = std::move(temp);
-    return *this;
+  string& string::operator+=(string_view sv)
+  {
+    return append_raw(sv.data(), sv.size());
   }
 
-  string& string::operator+=(const char* str)
+  string& string::operator+=(char c)
   {
-    string temp;
-    size_t strSize = std::strlen(str);
-    temp._size = _size + strSize;
-    temp._data = new char[temp._size + 1];
+    grow(_size + 1);
 
-    memcpy(temp._data, _data, _size);
-    memcpy(temp._data + _size, str, strSize);
-    temp._data[temp._size] = 0;
+    _data[_size] = c;
+    _size++;
+    _data[_size] = 0;
 
-    *this = std::move(temp);
     return *this;
   }
 
-  string& string::operator+=(char c)
+  namespace detail
+  {
+    /**
+     * @brief Vista su un pezzo di `concat` che è già una sequenza di caratteri.
+     */
+    string_view concat_view(string_view sv)
+    {
+      return sv;
+    }
+
+    /**
+     * @brief Vista su un pezzo di `concat` formato da un singolo carattere.
+     *
+     * Accetta solo un `char` vero: il riferimento punta all'argomento del chiamante, che vive fino
+     * alla fine dell'espressione che chiama `concat`.
+     */
+    template <typename T, typename std::enable_if<std::is_same<T, char>::value, int>::type = 0>
+    string_view concat_view(const T& c)
+    {
+      return string_view(&c, 1);
+    }
+
+    /**
+     * @brief Gli altri tipi numerici non sono pezzi validi di `concat`.
+     *
+     * Convertiti in un `char` temporaneo lascerebbero la vista a puntare a un oggetto già distrutto;
+     * per scrivere un numero usare `zkl::to_string` o `zkl::append_number`.
+     */
+    template <typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, char>::value, long>::type = 0>
+    string_view concat_view(const T&) = delete;
+  } // namespace detail
+
+  template <typename First, typename... Rest>
+  string concat(const First& first, const Rest&... rest)
   {
-    string temp;
-    temp._size = _size + 1;
-    temp._data = new char[temp._size + 1];
+    // measure every piece up front so the result is allocated only once
+    const string_view views[] = {detail::concat_view(first), detail::concat_view(rest)...};
 
-    memcpy(temp._data, _data, _size);
-    temp._data[temp._size - 1] = c;
-    temp._data[temp._size] = 0;
+    size_t total = 0;
+    for (const string_view& view : views)
+      total += view.size();
 
-    *this = std::move(temp);
-    return *this;
+    string str;
+    str.reserve(total);
+    for (const string_view& view : views)
+      str.append(view);
+
+    return str;
   }
 
   string operator+(const string& left, const string& right)
   {
-    string str(left);
-    str += right;
-    return str;
+    return concat(left, right);
   }
 
   string operator+(char left, const string& right)
   {
-    string str;
-    str._size = 1;
-    str._data = new char[2];
-    str[0] = left;
-    str[1] = 0;
-
-    str += right;
-    return str;
+    return concat(left, right);
   }
 
   string operator+(const string& left, char right)
   {
-    string str(left);
-    str += right;
-    return str;
+    return concat(left, right);
+  }
+
+  string operator+(const string& left, const char* right)
+  {
+    return concat(left, right);
+  }
+
+  string operator+(const char* left, const string& right)
+  {
+    return concat(left, right);
+  }
+
+  string operator+(string&& left, const string& right)
+  {
+    left += right;
+    return std::move(left);
+  }
+
+  string operator+(string&& left, const char* right)
+  {
+    left += right;
+    return std::move(left);
+  }
+
+  string operator+(string&& left, char right)
+  {
+    left += right;
+    return std::move(left);
   }
 
   string& string::append(const string& str)
@@ -317,18 +626,12 @@ namespace zkl
       sublen = str._size - subpos;
     }
 
-    if (sublen == 0)
-      return *this;
-
-    string temp;
-    temp._size = _size + sublen;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, _size);
-    std::memcpy(temp._data + _size, str._data + subpos, sublen);
-    temp._data[temp._size] = 0;
-    *this = std::move(temp);
+    return append_raw(str._data + subpos, sublen);
+  }
 
-    return *this;
+  string& string::append(string_view sv)
+  {
+    return append_raw(sv.data(), sv.size());
   }
 
   string& string::append(const char* str)
@@ -343,31 +646,18 @@ namespace zkl
     if (sublen > n)
       sublen = n;
 
-    if (sublen == 0)
-      return *this;
-
-    string temp;
-    temp._size = _size + sublen;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, _size);
-    std::memcpy(temp._data + _size, str, sublen);
-    temp._data[temp._size] = 0;
-
-    *this = std::move(temp);
-    return *this;
+    return append_raw(str, sublen);
   }
 
   string& string::append(size_t n, char c)
   {
     if (n != 0)
     {
-      string temp;
-      temp._size = _size + n;
-      temp._data = new char[temp._size + 1];
-      std::memcpy(temp._data, _data, _size);
-      std::memset(temp._data + _size, c, n);
-      temp._data[temp._size] = 0;
-      *this = std::move(temp);
+      grow(_size + n);
+
+      std::memset(_data + _size, c, n);
+      _size += n;
+      _data[_size] = 0;
     }
 
     return *this;
@@ -397,14 +687,33 @@ namespace zkl
       sublen = str._size - subpos;
     }
 
-    delete[] _data;
+    if (this == &str)
+    {
+      // keep the substring and drop the rest, all within our own buffer
+      if (subpos != 0)
+        std::memmove(_data, _data + subpos, sublen);
+      _size = sublen;
+      _data[_size] = 0;
+      return *this;
+    }
 
-    _size = sublen;
-    _data = new char[_size + 1];
-    std::memcpy(_data, str._data + subpos, sublen);
-    _data[_size] = 0;
+    clear();
+    return append_raw(str._data + subpos, sublen);
+  }
 
-    return *this;
+  string& string::assign(string_view sv)
+  {
+    // sv may be a view into our own buffer
+    if (sv.data() >= _data && sv.data() <= _data + _size)
+    {
+      std::memmove(_data, sv.data(), sv.size());
+      _size = sv.size();
+      _data[_size] = 0;
+      return *this;
+    }
+
+    clear();
+    return append_raw(sv.data(), sv.size());
   }
 
   string& string::assign(const string& str)
@@ -419,64 +728,43 @@ namespace zkl
     if (sublen > n)
       sublen = n;
 
-    delete[] _data;
-
-    _size = sublen;
-    _data = new char[_size + 1];
-    std::memcpy(_data, s, sublen);
-    _data[_size] = 0;
+    // s may point inside our own buffer, so shift it down instead of clearing first
+    if (s >= _data && s <= _data + _size)
+    {
+      std::memmove(_data, s, sublen);
+      _size = sublen;
+      _data[_size] = 0;
+      return *this;
+    }
 
-    return *this;
+    clear();
+    return append_raw(s, sublen);
   }
 
   string& string::assign(size_t n, char c)
   {
-    delete[] _data;
-
-    _size = n;
-    _data = new char[_size + 1];
-    std::memset(_data, c, _size);
-    _data[_size] = 0;
-
-    return *this;
+    clear();
+    return append(n, c);
   }
 
   string& string::insert(size_t pos, const string& str)
   {
-    if (pos > _size)
-      pos = _size;
-
-    string temp;
-    temp._size = _size + str._size;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, pos);
-    std::memcpy(temp._data + pos, str._data, str._size);
-    std::memcpy(temp._data + pos + str._size, _data + pos, _size - pos);
-    temp._data[temp._size] = 0;
-    *this = std::move(temp);
-
-    return *this;
+    return replace_raw(pos, 0, str._data, str._size);
   }
 
   string& string::insert(size_t pos, const char* str)
   {
-    size_t len = std::strlen(str);
-    if (len == 0)
-      return *this;
-
-    if (pos > _size)
-      pos = _size;
+    return replace_raw(pos, 0, str, std::strlen(str));
+  }
 
-    string temp;
-    temp._size = _size + len;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, pos);
-    std::memcpy(temp._data + pos, str, len);
-    std::memcpy(temp._data + pos + len, _data + pos, _size - pos);
-    temp._data[temp._size] = 0;
-    *this = std::move(temp);
+  string& string::insert(size_t pos, string_view sv)
+  {
+    return replace_raw(pos, 0, sv.data(), sv.size());
+  }
 
-    return *this;
+  string& string::insert(size_t pos, const char* str, size_t n)
+  {
+    return replace_raw(pos, 0, str, n);
   }
 
   string& string::erase(size_t pos, size_t len)
@@ -487,28 +775,82 @@ namespace zkl
     if (pos + len > _size || pos + len < pos)
       len = _size - pos;
 
-    string temp;
-    temp._size = _size - len;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, pos);
-    std::memcpy(temp._data + pos, _data + pos + len, _size - len - pos);
-    temp._data[temp._size] = 0;
+    // the string only gets shorter, so just close the gap
+    std::memmove(_data + pos, _data + pos + len, _size - len - pos);
+    _size -= len;
+    _data[_size] = 0;
 
-    *this = std::move(temp);
     return *this;
   }
 
   string& string::replace(size_t pos, size_t len, const string& str)
   {
-    erase(pos, len);
-    insert(pos, str);
-    return *this;
+    return replace_raw(pos, len, str._data, str._size);
   }
 
   string& string::replace(size_t pos, size_t len, const char* str)
   {
-    erase(pos, len);
-    insert(pos, str);
+    return replace_raw(pos, len, str, std::strlen(str));
+  }
+
+  string& string::replace(size_t pos, size_t len, string_view sv)
+  {
+    return replace_raw(pos, len, sv.data(), sv.size());
+  }
+
+  string& string::replace(size_t pos, size_t len, const char* str, size_t n)
+  {
+    return replace_raw(pos, len, str, n);
+  }
+
+  string& string::replace_raw(size_t pos, size_t len, const char* str, size_t n)
+  {
+    if (pos > _size)
+      pos = _size;
+
+    if (pos + len > _size || pos + len < pos)
+      len = _size - pos;
+
+    const size_t tailSize = _size - pos - len;
+    const size_t newSize = _size - len + n;
+    const size_t oldCapacity = capacity();
+
+    if (newSize > oldCapacity)
+    {
+      // build the result in a single pass; str may point inside the old
+      // buffer, which stays alive until everything has been copied
+      size_t newCapacity = oldCapacity * 2;
+      if (newCapacity < newSize)
+        newCapacity = newSize;
+
+      char* newData = allocate(newCapacity);
+      std::memcpy(newData, _data, pos);
+      std::memcpy(newData + pos, str, n);
+      std::memcpy(newData + pos + n, _data + pos + len, tailSize);
+      detail::stats_reallocated(stats::container::string, pos + tailSize);
+
+      if (!is_local())
+        deallocate(_data, _capacity);
+
+      _data = newData;
+      _capacity = newCapacity;
+    }
+    else if (str >= _data && str <= _data + _size && n != len)
+    {
+      // str is part of our own buffer and the tail is about to shift under
+      // it, so take a copy first (rare, only for self-replacements)
+      string temp;
+      temp.append_raw(str, n);
+      return replace_raw(pos, len, temp._data, n);
+    }
+    else
+    {
+      std::memmove(_data + pos + n, _data + pos + len, tailSize);
+      std::memmove(_data + pos, str, n);
+    }
+
+    _size = newSize;
+    _data[_size] = 0;
     return *this;
   }
 
@@ -524,12 +866,8 @@ namespace zkl
     if (_size == 0)
       return;
 
-    string temp;
-    temp._size = _size - 1;
-    temp._data = new char[temp._size + 1];
-    std::memcpy(temp._data, _data, temp._size);
-    temp._data[temp._size] = 0;
-    *this = std::move(temp);
+    _size--;
+    _data[_size] = 0;
   }
 
   const char* string::c_str() const noexcept
@@ -555,210 +893,89 @@ namespace zkl
     return len;
   }
 
-  size_t string::find(const string& str, size_t pos) const noexcept
+  size_t string::find(string_view str, size_t pos) const noexcept
   {
-    // si = string index, fi = find index
-    for (size_t si = pos; si < _size; si++)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0; fi++)
-      {
-        if (_data[si + fi] != str._data[fi])
-          break;
-      }
-      if (fi == str._size) // string found
-        return si;
-    }
-
-    return npos;
+    return string_view(*this).find(str, pos);
   }
 
   size_t string::find(char c, size_t pos) const noexcept
   {
-    for (size_t i = pos; i < _size; i++)
-    {
-      if (c == _data[i])
-        return i;
-    }
-
-    return npos;
+    return string_view(*this).find(c, pos);
   }
 
-  size_t string::find(const string& str, size_t pos, size_t n) const noexcept
+  size_t string::find(string_view str, size_t pos, size_t n) const noexcept
   {
-    // si = string index, fi = find index
-    for (size_t si = pos; si < _size; si++)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0 && fi != n; fi++)
-      {
-        if (_data[si + fi] != str._data[fi])
-          break;
-      }
-      if (fi == str._size || fi == n) // string found
-        return si;
-    }
-
-    return npos;
+    return string_view(*this).find(str, pos, n);
   }
 
-  size_t string::rfind(const string& str, size_t pos) const noexcept
+  size_t string::rfind(string_view str, size_t pos) const noexcept
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    // si = string index, fi = find index
-    for (size_t si = pos; si != npos; si--)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0; fi++)
-      {
-        if (_data[si + fi] != str._data[fi])
-          break;
-      }
-      if (fi == str._size) // string found
-        return si;
-    }
-
-    return npos;
+    return string_view(*this).rfind(str, pos);
   }
 
   size_t string::rfind(char c, size_t pos) const noexcept
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    for (size_t i = pos; i != npos; i--)
-    {
-      if (c == _data[i])
-        return i;
-    }
-
-    return npos;
+    return string_view(*this).rfind(c, pos);
   }
 
-  size_t string::find_first_of(const string& str, size_t pos) const
+  size_t string::find_first_of(string_view str, size_t pos) const
   {
-    // si = string index, fi = find index
-    for (size_t si = pos; si < _size; si++)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0; fi++)
-      {
-        if (_data[si] == str._data[fi])
-          return si; // match found
-      }
-    }
+    return string_view(*this).find_first_of(str, pos);
+  }
 
-    return npos;
+  size_t string::find_first_of(const char_set& set, size_t pos) const
+  {
+    return string_view(*this).find_first_of(set, pos);
   }
 
   size_t string::find_first_of(char c, size_t pos) const
   {
-    for (size_t i = pos; i < _size; i++)
-    {
-      if (_data[i] == c)
-        return i; // match found
-    }
-
-    return npos;
+    return string_view(*this).find_first_of(c, pos);
   }
 
-  size_t string::find_last_of(const string& str, size_t pos) const
+  size_t string::find_last_of(string_view str, size_t pos) const
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    // si = string index, fi = find index
-    for (size_t si = pos; si != npos; si--)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0; fi++)
-      {
-        if (_data[si] == str._data[fi])
-          return si; // match found
-      }
-    }
+    return string_view(*this).find_last_of(str, pos);
+  }
 
-    return npos;
+  size_t string::find_last_of(const char_set& set, size_t pos) const
+  {
+    return string_view(*this).find_last_of(set, pos);
   }
 
   size_t string::find_last_of(char c, size_t pos) const
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    for (size_t i = pos; i != npos; i--)
-    {
-      if (_data[i] == c)
-        return i; // match found
-    }
-
-    return npos;
+    return string_view(*this).find_last_of(c, pos);
   }
 
-  size_t string::find_first_not_of(const string& str, size_t pos) const
+  size_t string::find_first_not_of(string_view str, size_t pos) const
   {
-    // si = string index, fi = find index
-    for (size_t si = pos; si < _size; si++)
-    {
-      size_t fi;
-      for (fi = 0; str._data[fi] != 0; fi++)
-      {
-        if (_data[si] == str._data[fi])
-          break;
-      }
-      if (fi == str._size)
-        return si; // match found
-    }
+    return string_view(*this).find_first_not_of(str, pos);
+  }
 
-    return npos;
+  size_t string::find_first_not_of(const char_set& set, size_t pos) const
+  {
+    return string_view(*this).find_first_not_of(set, pos);
   }
 
   size_t string::find_first_not_of(char c, size_t pos) const
   {
-    for (size_t i = pos; i < _size; i++)
-    {
-      if (_data[i] != c)
-        return i; // match found
-    }
-
-    return npos;
+    return string_view(*this).find_first_not_of(c, pos);
   }
 
-  size_t string::find_last_not_of(const string& str, size_t pos) const
+  size_t string::find_last_not_of(string_view str, size_t pos) const
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    // si = string index, fi = find index
-    for (size_t si = pos; si != -1; si--)
-    {
-      size_t fi;
-      for (fi = 0; fi < str._size; fi++)
-      {
-        if (_data[si] == str._data[fi])
-          break;
-      }
-      if (fi == str._size)
-        return si; // match found
-    }
+    return string_view(*this).find_last_not_of(str, pos);
+  }
 
-    return npos;
+  size_t string::find_last_not_of(const char_set& set, size_t pos) const
+  {
+    return string_view(*this).find_last_not_of(set, pos);
   }
 
   size_t string::find_last_not_of(char c, size_t pos) const
   {
-    if (pos >= _size)
-      pos = _size - 1;
-
-    for (size_t i = pos; i != -1; i--)
-    {
-      if (_data[i] != c)
-        return i;
-    }
-
-    return npos;
+    return string_view(*this).find_last_not_of(c, pos);
   }
 
   string string::substr(size_t pos, size_t len) const
@@ -775,88 +992,20 @@ namespace zkl
 
     string str; // Won't create a copy since the compiler will do a NRVO
 
-    str._size = len;
-    str._data = new char[str._size + 1];
-    std::memcpy(str._data, _data + pos, len);
-    str._data[str._size] = 0;
+    str.reserve(len);
+    str.append_raw(_data + pos, len);
 
     return str;
   }
 
-  int string::compare(const string& str) const noexcept
-  {
-    for (size_t i = 0; i < _size && i < str._size; i++)
-    {
-      const int diff = _data[i] - str._data[i];
-      if (diff != 0)
-        return diff;
-    }
-
-    if (_size > str._size)
-      return 1;
-    if (_size < str._size)
-      return -1;
-    return 0; // seems silly but needed for when both strings are empty
-  }
-
-  int string::compare(size_t pos, size_t len, const string& str) const noexcept
-  {
-    if (pos > _size)
-    {
-      throw std::out_of_range("Position out of range");
-    }
-
-    // ti = this' data index, si = str's data index
-    size_t ti;
-    size_t si;
-    for (ti = pos, si = 0; ti < _size && si < str._size && si < len; ti++, si++)
-    {
-      const int diff = _data[ti] - str._data[si];
-      if (diff != 0)
-        return diff;
-    }
-
-    // case: all matches except len is bigger than str's size
-    // return remaining length (negative size_t) which is capped by str's size
-    if (len > si)
-      return (pos + len > _size ? _size - pos - si : len - si);
-
-    // case: all matches except len is shorter than str's size
-    // return missing length (positive size_t)
-    if (len < str._size)
-      return len - str._size;
-
-    return 0;
-  }
-
-  bool operator==(const string& lhs, const string& rhs) noexcept
-  {
-    return lhs.compare(rhs) == 0;
-  }
-
-  bool operator!=(const string& lhs, const string& rhs) noexcept
-  {
-    return lhs.compare(rhs) != 0;
-  }
-
-  bool operator<(const string& lhs, const string& rhs) noexcept
-  {
-    return lhs.compare(rhs) < 0;
-  }
-
-  bool operator<=(const string& lhs, const string& rhs) noexcept
-  {
-    return lhs.compare(rhs) <= 0;
-  }
-
-  bool operator>(const string& lhs, const string& rhs) noexcept
+  int string::compare(string_view str) const noexcept
   {
-    return lhs.compare(rhs) > 0;
+    return string_view(*this).compare(str);
   }
 
-  bool operator>=(const string& lhs, const string& rhs) noexcept
+  int string::compare(size_t pos, size_t len, string_view str) const noexcept
   {
-    return lhs.compare(rhs) >= 0;
+    return string_view(*this).compare(pos, len, str);
   }
 
   void swap(string& x, string& y)
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "searcher.tpp"
+#include "simd.tpp"
+#include "zkl.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace zkl
+{
+  string_view::string_view() noexcept : _data(""), _size(0)
+  {
+  }
+
+  string_view::string_view(const char* str) : _data(str), _size(std::strlen(str))
+  {
+  }
+
+  string_view::string_view(const char* str, size_t n) noexcept : _data(str), _size(n)
+  {
+  }
+
+  string_view::string_view(const string& str) noexcept : _data(str.data()), _size(str.size())
+  {
+  }
+
+  size_t string_view::size() const noexcept
+  {
+    return _size;
+  }
+
+  size_t string_view::length() const noexcept
+  {
+    return _size;
+  }
+
+  bool string_view::empty() const noexcept
+  {
+    return _size == 0;
+  }
+
+  const char& string_view::operator[](const size_t index) const
+  {
+    return _data[index];
+  }
+
+  const char& string_view::at(const size_t index) const
+  {
+    if (index >= _size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+
+    return _data[index];
+  }
+
+  const char& string_view::front() const
+  {
+    return _data[0];
+  }
+
+  const char& string_view::back() const
+  {
+    return _data[_size - 1];
+  }
+
+  const char* string_view::data() const noexcept
+  {
+    return _data;
+  }
+
+  void string_view::remove_prefix(size_t n)
+  {
+    _data += n;
+    _size -= n;
+  }
+
+  void string_view::remove_suffix(size_t n)
+  {
+    _size -= n;
+  }
+
+  void string_view::swap(string_view& sv) noexcept
+  {
+    string_view temp = *this;
+    *this = sv;
+    sv = temp;
+  }
+
+  size_t string_view::copy(char* s, size_t len, size_t pos) const
+  {
+    if (pos >= _size)
+      return 0;
+
+    if (pos + len > _size || pos + len < pos)
+      len = _size - pos;
+
+    // if s doesn't have enough space, will cause undefined behavior
+    std::memcpy(s, _data + pos, len);
+    return len;
+  }
+
+  string_view string_view::substr(size_t pos, size_t len) const
+  {
+    if (pos > _size)
+    {
+      throw std::out_of_range("Position out of range");
+    }
+
+    if (pos + len > _size || pos + len < pos)
+      len = _size - pos;
+
+    return string_view(_data + pos, len);
+  }
+
+  int string_view::compare(string_view sv) const noexcept
+  {
+    size_t len = _size < sv._size ? _size : sv._size;
+    int diff = len != 0 ? std::memcmp(_data, sv._data, len) : 0;
+    if (diff != 0)
+      return diff;
+
+    if (_size > sv._size)
+      return 1;
+    if (_size < sv._size)
+      return -1;
+    return 0;
+  }
+
+  int string_view::compare(size_t pos, size_t len, string_view sv) const
+  {
+    return substr(pos, len).compare(sv);
+  }
+
+  bool string_view::starts_with(string_view sv) const noexcept
+  {
+    return _size >= sv._size && std::memcmp(_data, sv._data, sv._size) == 0;
+  }
+
+  bool string_view::ends_with(string_view sv) const noexcept
+  {
+    return _size >= sv._size && std::memcmp(_data + _size - sv._size, sv._data, sv._size) == 0;
+  }
+
+  size_t string_view::find(string_view str, size_t pos) const noexcept
+  {
+    return find(str, pos, str._size);
+  }
+
+  size_t string_view::find(char c, size_t pos) const noexcept
+  {
+    if (pos >= _size)
+      return npos;
+
+    size_t i = detail::char_search().find(_data + pos, _size - pos, c);
+    return i == detail::not_found ? npos : pos + i;
+  }
+
+  size_t string_view::find(string_view str, size_t pos, size_t n) const noexcept
+  {
+    if (n > str._size)
+      n = str._size;
+
+    // the shift table only pays for itself on long haystacks
+    size_t shift[256];
+    const size_t* table = nullptr;
+    if (n > 2 && pos < _size && _size - pos >= _shiftTableThreshold)
+    {
+      detail::build_shift_table(str._data, n, shift);
+      table = shift;
+    }
+
+    size_t found = detail::search_forward(_data, _size, pos, str._data, n, table);
+    return found == detail::not_found ? npos : found;
+  }
+
+  size_t string_view::rfind(string_view str, size_t pos) const noexcept
+  {
+    size_t rshift[256];
+    const size_t* table = nullptr;
+    if (str._size > 2 && _size >= _shiftTableThreshold)
+    {
+      detail::build_rshift_table(str._data, str._size, rshift);
+      table = rshift;
+    }
+
+    size_t found = detail::search_backward(_data, _size, pos, str._data, str._size, table);
+    return found == detail::not_found ? npos : found;
+  }
+
+  size_t string_view::rfind(char c, size_t pos) const noexcept
+  {
+    if (_size == 0)
+      return npos;
+
+    if (pos >= _size)
+      pos = _size - 1;
+
+    return detail::char_search().rfind(_data, pos + 1, c);
+  }
+
+  size_t string_view::find_first_of(string_view str, size_t pos) const
+  {
+    return find_first_of(char_set(str), pos);
+  }
+
+  size_t string_view::find_first_of(const char_set& set, size_t pos) const
+  {
+    if (pos >= _size)
+      return npos;
+
+    size_t i = set.scan(_data + pos, _size - pos, false);
+    return i == detail::not_found ? npos : pos + i;
+  }
+
+  size_t string_view::find_first_of(char c, size_t pos) const
+  {
+    return find(c, pos);
+  }
+
+  size_t string_view::find_last_of(string_view str, size_t pos) const
+  {
+    return find_last_of(char_set(str), pos);
+  }
+
+  size_t string_view::find_last_of(const char_set& set, size_t pos) const
+  {
+    if (_size == 0)
+      return npos;
+
+    if (pos >= _size)
+      pos = _size - 1;
+
+    return set.rscan(_data, pos + 1, false);
+  }
+
+  size_t string_view::find_last_of(char c, size_t pos) const
+  {
+    return rfind(c, pos);
+  }
+
+  size_t string_view::find_first_not_of(string_view str, size_t pos) const
+  {
+    return find_first_not_of(char_set(str), pos);
+  }
+
+  size_t string_view::find_first_not_of(const char_set& set, size_t pos) const
+  {
+    if (pos >= _size)
+      return npos;
+
+    size_t i = set.scan(_data + pos, _size - pos, true);
+    return i == detail::not_found ? npos : pos + i;
+  }
+
+  size_t string_view::find_first_not_of(char c, size_t pos) const
+  {
+    if (pos >= _size)
+      return npos;
+
+    size_t i = detail::char_search().find_not(_data + pos, _size - pos, c);
+    return i == detail::not_found ? npos : pos + i;
+  }
+
+  size_t string_view::find_last_not_of(string_view str, size_t pos) const
+  {
+    return find_last_not_of(char_set(str), pos);
+  }
+
+  size_t string_view::find_last_not_of(const char_set& set, size_t pos) const
+  {
+    if (_size == 0)
+      return npos;
+
+    if (pos >= _size)
+      pos = _size - 1;
+
+    return set.rscan(_data, pos + 1, true);
+  }
+
+  size_t string_view::find_last_not_of(char c, size_t pos) const
+  {
+    if (_size == 0)
+      return npos;
+
+    if (pos >= _size)
+      pos = _size - 1;
+
+    return detail::char_search().rfind_not(_data, pos + 1, c);
+  }
+
+  std::ostream& operator<<(std::ostream& os, string_view sv)
+  {
+    os.write(sv.data(), sv.size());
+    return os;
+  }
+
+  bool operator==(string_view lhs, string_view rhs) noexcept
+  {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+  }
+
+  bool operator!=(string_view lhs, string_view rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+  bool operator<(string_view lhs, string_view rhs) noexcept
+  {
+    return lhs.compare(rhs) < 0;
+  }
+
+  bool operator<=(string_view lhs, string_view rhs) noexcept
+  {
+    return lhs.compare(rhs) <= 0;
+  }
+
+  bool operator>(string_view lhs, string_view rhs) noexcept
+  {
+    return lhs.compare(rhs) > 0;
+  }
+
+  bool operator>=(string_view lhs, string_view rhs) noexcept
+  {
+    return lhs.compare(rhs) >= 0;
+  }
+} // namespace zkl
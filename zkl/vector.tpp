@@ -1,72 +1,348 @@
 #pragma once
 
 #include "zkl.hpp"
+#include <cstring>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace zkl
 {
-  template <typename T>
-  vector<T>::vector()
-      : _array(nullptr), _size(0), _capacity(0)
+  template <size_t Numerator, size_t Denominator, bool AutoShrink>
+  size_t growth_policy<Numerator, Denominator, AutoShrink>::grow(size_t capacity, size_t required) noexcept
   {
+    size_t grown = capacity <= static_cast<size_t>(-1) / Numerator ? capacity * Numerator / Denominator : capacity;
+    if (grown <= capacity)
+      grown = capacity + 1;
+
+    return grown < required ? required : grown;
+  }
+
+  template <size_t Numerator, size_t Denominator, bool AutoShrink>
+  size_t growth_policy<Numerator, Denominator, AutoShrink>::shrink(size_t size, size_t capacity) noexcept
+  {
+    if (!AutoShrink)
+      return capacity;
+
+    // shrink by one growth step only once size has fallen two steps below capacity, so
+    // alternating push/pop near a boundary never reallocates in both directions
+    size_t target = capacity * Denominator / Numerator;
+    size_t threshold = target * Denominator / Numerator;
+    if (size > threshold || target >= capacity)
+      return capacity;
+
+    return target;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  T* vector<T, GrowthPolicy, Allocator>::allocate(size_t count)
+  {
+    if (count == 0)
+      return nullptr;
+
+    if (count > alloc_traits::max_size(_allocator))
+    {
+      throw std::length_error("Vector too long");
+    }
+
+    T* array = alloc_traits::allocate(_allocator, count);
+    detail::stats_allocated(stats::container::vector, count * sizeof(T));
+    return array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::deallocate(T* array, size_t count) noexcept
+  {
+    if (array != nullptr)
+    {
+      alloc_traits::deallocate(_allocator, array, count);
+      detail::stats_freed(stats::container::vector, count * sizeof(T));
+    }
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::destroy(T* array, size_t count) noexcept
+  {
+    if (std::is_trivially_destructible<T>::value)
+      return;
+
+    for (size_t i = 0; i < count; i++)
+      alloc_traits::destroy(_allocator, array + i);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::relocate(T* from, size_t count, T* to)
+  {
+    if (count == 0)
+      return;
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+      std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+      return;
+    }
+
+    // move_if_noexcept copies when moving could throw, so a failure leaves `from` untouched
+    size_t constructed = 0;
+    try
+    {
+      for (; constructed < count; constructed++)
+        alloc_traits::construct(_allocator, to + constructed, std::move_if_noexcept(from[constructed]));
+    }
+    catch (...)
+    {
+      destroy(to, constructed);
+      throw;
+    }
+
+    destroy(from, count);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::steal(vector& other) noexcept
+  {
+    destroy(_array, _size);
+    deallocate(_array, _capacity);
+
+    _array = other._array;
+    _size = other._size;
+    _capacity = other._capacity;
+    other._array = nullptr;
+    other._size = 0;
+    other._capacity = 0;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector()
+      : _array(nullptr), _size(0), _capacity(0), _allocator()
+  {
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector(const Allocator& allocator)
+      : _array(nullptr), _size(0), _capacity(0), _allocator(allocator)
+  {
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector(size_t initialCapacity, const Allocator& allocator)
+      : _array(nullptr), _size(0), _capacity(0), _allocator(allocator)
+  {
+    _array = allocate(initialCapacity);
+    _capacity = initialCapacity;
   }
 
-  template <typename T>
-  vector<T>::vector(size_t initialCapacity) : _array(nullptr), _size(0), _capacity(initialCapacity) {}
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector(const vector& other)
+      : vector(other, alloc_traits::select_on_container_copy_construction(other._allocator))
+  {
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector(const vector& other, const Allocator& allocator)
+      : _array(nullptr), _size(0), _capacity(0), _allocator(allocator)
+  {
+    _array = allocate(other._size);
+    _capacity = other._size;
+
+    try
+    {
+      for (; _size < other._size; _size++)
+        alloc_traits::construct(_allocator, _array + _size, other._array[_size]);
+    }
+    catch (...)
+    {
+      destroy(_array, _size);
+      deallocate(_array, _capacity);
+      throw;
+    }
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::vector(vector&& other) noexcept
+      : _array(other._array), _size(other._size), _capacity(other._capacity), _allocator(std::move(other._allocator))
+  {
+    other._array = nullptr;
+    other._size = 0;
+    other._capacity = 0;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>::~vector()
+  {
+    destroy(_array, _size);
+    deallocate(_array, _capacity);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>& vector<T, GrowthPolicy, Allocator>::operator=(const vector& other)
+  {
+    if (this == &other)
+      return *this;
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    {
+      // memory from the old allocator must go back to it before the allocator is replaced
+      if (_allocator != other._allocator)
+      {
+        vector empty(_allocator);
+        steal(empty);
+      }
+      _allocator = other._allocator;
+    }
+
+    vector copy(other, _allocator);
+    steal(copy);
+    return *this;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  vector<T, GrowthPolicy, Allocator>& vector<T, GrowthPolicy, Allocator>::operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+  {
+    if (this == &other)
+      return *this;
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    {
+      vector empty(_allocator);
+      steal(empty);
+      _allocator = std::move(other._allocator);
+      steal(other);
+    }
+    else
+    {
+      if (_allocator == other._allocator)
+      {
+        steal(other);
+        return *this;
+      }
+
+      // different memory resources: the elements have to move into memory from our allocator
+      vector moved(_allocator);
+      moved.reserve(other._size);
+      for (size_t i = 0; i < other._size; i++)
+        moved.emplace_back(std::move(other._array[i]));
+      steal(moved);
+      other.clear();
+    }
+
+    return *this;
+  }
 
-  template <typename T>
-  vector<T>::~vector()
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  Allocator vector<T, GrowthPolicy, Allocator>::get_allocator() const
   {
-    delete[] _array;
+    return _allocator;
   }
 
-  template <typename T>
-  void vector<T>::reallocate(size_t newCapacity)
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::reallocate(size_t newCapacity)
   {
-    T* newArray = new T[newCapacity];
+    T* newArray = allocate(newCapacity);
 
-    for (size_t i = 0; i < _size; ++i)
+    try
     {
-      newArray[i] = _array[i];
+      relocate(_array, _size, newArray);
+    }
+    catch (...)
+    {
+      deallocate(newArray, newCapacity);
+      throw;
     }
 
-    delete[] _array;
+    if (_array != nullptr)
+      detail::stats_reallocated(stats::container::vector, _size * sizeof(T));
+    deallocate(_array, _capacity);
 
     _array = newArray;
     _capacity = newCapacity;
   }
 
-  template <typename T>
-  void vector<T>::push_back(const T& value)
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::push_back(const T& value)
+  {
+    emplace_back(value);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::push_back(T&& value)
   {
-    if (_size >= _capacity)
+    emplace_back(std::move(value));
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  template <typename... Args>
+  T& vector<T, GrowthPolicy, Allocator>::emplace_back(Args&&... args)
+  {
+    if (_size < _capacity)
     {
-      size_t newCapacity = (_capacity == 0) ? 1 : _capacity * 2;
-      reallocate(newCapacity);
+      alloc_traits::construct(_allocator, _array + _size, std::forward<Args>(args)...);
+      return _array[_size++];
+    }
+
+    // the new element is built before the old ones move, because args may refer to them
+    size_t newCapacity = GrowthPolicy::grow(_capacity, _size + 1);
+    T* newArray = allocate(newCapacity);
+
+    try
+    {
+      alloc_traits::construct(_allocator, newArray + _size, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      deallocate(newArray, newCapacity);
+      throw;
     }
 
-    _array[_size] = value;
-    _size++;
+    try
+    {
+      relocate(_array, _size, newArray);
+    }
+    catch (...)
+    {
+      alloc_traits::destroy(_allocator, newArray + _size);
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    if (_array != nullptr)
+      detail::stats_reallocated(stats::container::vector, _size * sizeof(T));
+    deallocate(_array, _capacity);
+    _array = newArray;
+    _capacity = newCapacity;
+
+    return _array[_size++];
   }
 
-  template <typename T>
-  void vector<T>::pop_back()
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::pop_back()
   {
     if (_size == 0)
     {
       throw std::out_of_range("Vector is empty");
     }
     _size--;
+    alloc_traits::destroy(_allocator, _array + _size);
 
-    size_t halfCapacity = _capacity / 2;
-    if (_size < halfCapacity && halfCapacity >= 1)
+    size_t newCapacity = GrowthPolicy::shrink(_size, _capacity);
+    if (newCapacity < _capacity)
+      reallocate(newCapacity);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  T& vector<T, GrowthPolicy, Allocator>::at(size_t index)
+  {
+    if (index >= _size)
     {
-      reallocate(halfCapacity);
+      throw std::out_of_range("Index out of range");
     }
+
+    return _array[index];
   }
 
-  template <typename T>
-  T& vector<T>::at(size_t index)
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  const T& vector<T, GrowthPolicy, Allocator>::at(size_t index) const
   {
     if (index >= _size)
     {
@@ -76,54 +352,143 @@ namespace zkl
     return _array[index];
   }
 
-  template <typename T>
-  const T& vector<T>::at(size_t index) const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  T& vector<T, GrowthPolicy, Allocator>::operator[](size_t index)
   {
-    return at(index);
+    return _array[index];
   }
 
-  template <typename T>
-  T& vector<T>::operator[](size_t index)
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  const T& vector<T, GrowthPolicy, Allocator>::operator[](size_t index) const
   {
     return _array[index];
   }
 
-  template <typename T>
-  const T& vector<T>::operator[](size_t index) const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  T* vector<T, GrowthPolicy, Allocator>::data() noexcept
   {
-    return _array[index];
+    return _array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  const T* vector<T, GrowthPolicy, Allocator>::data() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::iterator vector<T, GrowthPolicy, Allocator>::begin() noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::const_iterator vector<T, GrowthPolicy, Allocator>::begin() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::const_iterator vector<T, GrowthPolicy, Allocator>::cbegin() const noexcept
+  {
+    return _array;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::iterator vector<T, GrowthPolicy, Allocator>::end() noexcept
+  {
+    return _array + _size;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::const_iterator vector<T, GrowthPolicy, Allocator>::end() const noexcept
+  {
+    return _array + _size;
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  typename vector<T, GrowthPolicy, Allocator>::const_iterator vector<T, GrowthPolicy, Allocator>::cend() const noexcept
+  {
+    return _array + _size;
   }
 
-  template <typename T>
-  size_t vector<T>::size() const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  size_t vector<T, GrowthPolicy, Allocator>::size() const
   {
     return _size;
   }
 
-  template <typename T>
-  size_t vector<T>::capacity() const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  size_t vector<T, GrowthPolicy, Allocator>::capacity() const
   {
     return _capacity;
   }
 
-  template <typename T>
-  bool vector<T>::empty() const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  bool vector<T, GrowthPolicy, Allocator>::empty() const
   {
     return _size == 0;
   }
 
-  template <typename T>
-  void vector<T>::clear() const
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::clear() noexcept
   {
+    destroy(_array, _size);
     _size = 0;
-    reallocate(0);
   }
 
-  template <typename T>
-  void vector<T>::reserve(size_t newCapacity)
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::reserve(size_t newCapacity)
   {
-    if (capacity >= newCapacity)
+    if (_capacity >= newCapacity)
       return;
     reallocate(newCapacity);
   }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::shrink_to_fit()
+  {
+    if (_capacity > _size)
+      reallocate(_size);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::resize(size_t newSize)
+  {
+    if (newSize < _size)
+    {
+      destroy(_array + newSize, _size - newSize);
+      _size = newSize;
+      return;
+    }
+
+    if (newSize > _capacity)
+      reallocate(newSize);
+
+    for (; _size < newSize; _size++)
+      alloc_traits::construct(_allocator, _array + _size);
+  }
+
+  template <typename T, typename GrowthPolicy, typename Allocator>
+  void vector<T, GrowthPolicy, Allocator>::swap(vector& other) noexcept
+  {
+    // like std::vector, non-propagating allocators are expected to compare equal
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+      using std::swap;
+      swap(_allocator, other._allocator);
+    }
+
+    T* array = _array;
+    _array = other._array;
+    other._array = array;
+
+    size_t size = _size;
+    _size = other._size;
+    other._size = size;
+
+    size_t capacity = _capacity;
+    _capacity = other._capacity;
+    other._capacity = capacity;
+  }
 } // namespace zkl
@@ -1,49 +1,333 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
 #include <istream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace zkl
 {
+  /**
+   * @brief Statistiche sulle allocazioni dei contenitori zkl.
+   *
+   * I contatori esistono solo se `ZKL_STATS` è definita prima di includere `zkl.hpp` (per esempio
+   * con `-DZKL_STATS`); altrimenti i punti di registrazione sono funzioni vuote che il compilatore
+   * elimina, `snapshot()` restituisce zeri e il costo è nullo. I contatori sono atomici e globali:
+   * con più thread i valori sono coerenti ma non formano un'istantanea atomica.
+   */
+  namespace stats
+  {
+#ifdef ZKL_STATS
+    const bool enabled = true;
+#else
+    const bool enabled = false;
+#endif
+
+    /**
+     * @brief I contenitori con contatori separati.
+     */
+    enum class container
+    {
+      string,      /**< Buffer di `zkl::string` (solo quelli sullo heap). */
+      vector,      /**< Array di `zkl::vector`. */
+      small_vector /**< Array di `zkl::small_vector` fuori dal buffer interno. */
+    };
+
+    /**
+     * @brief Contatori di un contenitore.
+     */
+    struct counters
+    {
+      uint64_t allocations = 0;    /**< Blocchi allocati. */
+      uint64_t frees = 0;          /**< Blocchi liberati. */
+      uint64_t bytesAllocated = 0; /**< Byte allocati in totale. */
+      uint64_t reallocations = 0;  /**< Crescite o riduzioni che hanno spostato il contenuto in un nuovo blocco. */
+      uint64_t bytesCopied = 0;    /**< Byte copiati o spostati da quelle riallocazioni. */
+      uint64_t liveBytes = 0;      /**< Byte allocati e non ancora liberati. */
+      uint64_t peakLiveBytes = 0;  /**< Massimo di `liveBytes`. */
+    };
+
+    /**
+     * @brief I contatori di tutti i contenitori in un dato momento.
+     */
+    struct report
+    {
+      counters strings;      /**< Contatori di `zkl::string`. */
+      counters vectors;      /**< Contatori di `zkl::vector`. */
+      counters smallVectors; /**< Contatori di `zkl::small_vector`. */
+
+      /**
+       * @brief Restituisce i contatori di un contenitore.
+       */
+      const counters& operator[](container c) const noexcept;
+    };
+
+    /**
+     * @brief Legge i contatori dall'avvio del programma (o dall'ultimo `reset()`).
+     *
+     * @return I contatori correnti; tutti zero se `ZKL_STATS` non è definita.
+     */
+    report snapshot() noexcept;
+
+    /**
+     * @brief Azzera i contatori; `liveBytes` resta invariato perché i blocchi vivi esistono ancora.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Misura le allocazioni di una regione di codice, dalla costruzione alla chiamata di `delta()`.
+     *
+     * Durante la vita dell'oggetto `peakLiveBytes` segue il massimo raggiunto nella regione; alla
+     * distruzione torna al massimo globale. Gli scope possono essere annidati, purché sullo stesso
+     * thread e distrutti in ordine inverso.
+     */
+    class scope
+    {
+    public:
+      scope() noexcept;
+      ~scope();
+
+      scope(const scope&) = delete;
+      scope& operator=(const scope&) = delete;
+
+      /**
+       * @brief Restituisce i contatori accumulati dalla costruzione.
+       *
+       * @return Differenze per i contatori cumulativi; `liveBytes` e `peakLiveBytes` sono invece i
+       * byte vivi ora e il massimo raggiunto durante lo scope.
+       */
+      report delta() const noexcept;
+
+    private:
+      report _start; /**< I contatori alla costruzione, con il massimo globale da ripristinare. */
+    };
+  } // namespace stats
+
+  namespace detail
+  {
+#ifdef ZKL_STATS
+    /**
+     * @brief Registra l'allocazione di un blocco di `bytes` byte.
+     */
+    void stats_allocated(stats::container c, size_t bytes) noexcept;
+
+    /**
+     * @brief Registra la liberazione di un blocco di `bytes` byte.
+     */
+    void stats_freed(stats::container c, size_t bytes) noexcept;
+
+    /**
+     * @brief Registra una riallocazione che ha copiato o spostato `bytes` byte nel nuovo blocco.
+     */
+    void stats_reallocated(stats::container c, size_t bytes) noexcept;
+#else
+    inline void stats_allocated(stats::container, size_t) noexcept {}
+    inline void stats_freed(stats::container, size_t) noexcept {}
+    inline void stats_reallocated(stats::container, size_t) noexcept {}
+#endif
+  } // namespace detail
+
+  /**
+   * @brief Politica di crescita e riduzione della capacità di `zkl::vector`.
+   *
+   * Quando il vettore è pieno la capacità viene moltiplicata per `Numerator / Denominator`.
+   * Con `AutoShrink` la capacità viene ridotta di un fattore solo quando la dimensione scende
+   * sotto la capacità divisa per il fattore al quadrato (isteresi), così una sequenza di
+   * `push_back` e `pop_back` attorno a una soglia non rialloca mai. Senza `AutoShrink` la memoria
+   * viene restituita solo con `shrink_to_fit()`.
+   *
+   * Una politica personalizzata deve fornire le stesse due funzioni statiche.
+   *
+   * @tparam Numerator Numeratore del fattore di crescita.
+   * @tparam Denominator Denominatore del fattore di crescita (il fattore deve essere maggiore di 1).
+   * @tparam AutoShrink Se `pop_back` può ridurre la capacità.
+   */
+  template <size_t Numerator = 2, size_t Denominator = 1, bool AutoShrink = true>
+  struct growth_policy
+  {
+    static_assert(Numerator > Denominator && Denominator > 0, "The growth factor must be greater than 1");
+
+    /**
+     * @brief Restituisce la nuova capacità quando il vettore è pieno.
+     *
+     * @param capacity La capacità attuale.
+     * @param required Il numero minimo di elementi da poter contenere.
+     * @return La nuova capacità, almeno `required` e maggiore di `capacity`.
+     */
+    static size_t grow(size_t capacity, size_t required) noexcept;
+
+    /**
+     * @brief Restituisce la capacità da mantenere dopo la rimozione di un elemento.
+     *
+     * @param size La dimensione dopo la rimozione.
+     * @param capacity La capacità attuale.
+     * @return La nuova capacità, o `capacity` per non riallocare.
+     */
+    static size_t shrink(size_t size, size_t capacity) noexcept;
+  };
+
   /**
    * @brief Classe che implementa un vettore dinamico simile a std::vector.
    *
+   * La memoria viene ottenuta da `Allocator` tramite `std::allocator_traits`, quindi funzionano sia
+   * gli allocatori in stile standard (come `zkl::pool_allocator`) sia `std::pmr::polymorphic_allocator`
+   * (ad esempio su una `zkl::monotonic_arena`).
+   *
    * @tparam T Il tipo di elementi memorizzati nel vettore.
+   * @tparam GrowthPolicy La politica di crescita e riduzione della capacità (vedi `growth_policy`).
+   * @tparam Allocator L'allocatore della memoria degli elementi.
    */
-  template <typename T>
+  template <typename T, typename GrowthPolicy = growth_policy<>, typename Allocator = std::allocator<T>>
   class vector
   {
+  public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
   private:
-    T* _array;        /**< Puntatore all'array dinamico che contiene gli elementi. */
-    size_t _size;     /**< Numero corrente di elementi nel vettore. */
-    size_t _capacity; /**< Capacità corrente del vettore (numero massimo di elementi prima del riallocamento). */
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+
+    T* _array;            /**< Memoria non inizializzata per `_capacity` elementi; solo i primi `_size` sono costruiti. */
+    size_t _size;         /**< Numero corrente di elementi nel vettore. */
+    size_t _capacity;     /**< Capacità corrente del vettore (numero massimo di elementi prima del riallocamento). */
+    Allocator _allocator; /**< Allocatore della memoria e degli elementi. */
+
+    /**
+     * @brief Alloca memoria non inizializzata per `count` elementi.
+     *
+     * @return Puntatore alla memoria, o `nullptr` se `count` è 0.
+     */
+    T* allocate(size_t count);
+
+    /**
+     * @brief Libera memoria ottenuta da `allocate` senza distruggere elementi.
+     *
+     * @param array La memoria da liberare (può essere `nullptr`).
+     * @param count Il numero di elementi per cui era stata allocata.
+     */
+    void deallocate(T* array, size_t count) noexcept;
+
+    /**
+     * @brief Distrugge gli elementi di `array[0, count)`.
+     */
+    void destroy(T* array, size_t count) noexcept;
+
+    /**
+     * @brief Trasferisce `count` elementi da `from` alla memoria non inizializzata `to`.
+     *
+     * Usa un'unica memcpy per i tipi banalmente copiabili, lo spostamento se è `noexcept` e altrimenti
+     * la copia. Gli elementi di `from` vengono distrutti solo a trasferimento riuscito; se una copia
+     * lancia un'eccezione `from` resta intatto.
+     */
+    void relocate(T* from, size_t count, T* to);
 
     /**
      * @brief Rialloca l'array interno a una nuova capacità.
      *
-     * @param newCapacity La nuova capacità desiderata.
+     * @param newCapacity La nuova capacità desiderata, almeno pari a `_size`.
      */
     void reallocate(size_t newCapacity);
 
+    /**
+     * @brief Distrugge gli elementi, libera l'array e prende quello di `other`, che rimane vuoto.
+     */
+    void steal(vector& other) noexcept;
+
   public:
     /**
      * @brief Costruttore di default. Inizializza un vettore vuoto.
      */
     vector();
 
+    /**
+     * @brief Costruisce un vettore vuoto che userà l'allocatore specificato.
+     *
+     * @param allocator L'allocatore da usare.
+     */
+    explicit vector(const Allocator& allocator);
+
     /**
      * @brief Costruttore che inizializza il vettore con una capacità iniziale specificata.
      *
+     * Alloca la memoria ma non costruisce alcun elemento.
+     *
      * @param initialCapacity La capacità iniziale del vettore.
+     * @param allocator L'allocatore da usare.
+     */
+    vector(size_t initialCapacity, const Allocator& allocator = Allocator());
+
+    /**
+     * @brief Costruttore di copia. Copia tutti gli elementi.
+     *
+     * L'allocatore è scelto da `select_on_container_copy_construction`.
+     *
+     * @param other Il vettore da copiare.
+     */
+    vector(const vector& other);
+
+    /**
+     * @brief Costruttore di copia con un allocatore specificato.
+     *
+     * @param other Il vettore da copiare.
+     * @param allocator L'allocatore della copia.
+     */
+    vector(const vector& other, const Allocator& allocator);
+
+    /**
+     * @brief Costruttore di spostamento. Trasferisce l'array e l'allocatore senza toccare gli elementi.
+     *
+     * @param other Il vettore da spostare, che rimane vuoto.
      */
-    vector(size_t initialCapacity);
+    vector(vector&& other) noexcept;
 
     /**
-     * @brief Distruttore. Libera la memoria allocata per l'array.
+     * @brief Distruttore. Distrugge gli elementi e libera la memoria allocata per l'array.
      */
     ~vector();
 
+    /**
+     * @brief Operatore di assegnazione di copia.
+     *
+     * @param other Il vettore da copiare.
+     * @return Riferimento al vettore assegnato.
+     */
+    vector& operator=(const vector& other);
+
+    /**
+     * @brief Operatore di assegnazione di spostamento.
+     *
+     * Se l'allocatore non si propaga ed è diverso da quello di `other`, gli elementi vengono spostati
+     * uno alla volta nella memoria di questo vettore.
+     *
+     * @param other Il vettore da spostare, che rimane vuoto.
+     * @return Riferimento al vettore assegnato.
+     */
+    vector& operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value);
+
+    /**
+     * @brief Restituisce una copia dell'allocatore.
+     *
+     * @return L'allocatore del vettore.
+     */
+    Allocator get_allocator() const;
+
     /**
      * @brief Aggiunge un elemento alla fine del vettore.
      *
@@ -51,9 +335,27 @@ namespace zkl
      */
     void push_back(const T& value);
 
+    /**
+     * @brief Aggiunge un elemento alla fine del vettore spostandolo.
+     *
+     * @param value L'elemento da spostare.
+     */
+    void push_back(T&& value);
+
+    /**
+     * @brief Costruisce un elemento direttamente alla fine del vettore.
+     *
+     * @param args Gli argomenti del costruttore di `T`.
+     * @return Riferimento all'elemento costruito.
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
     /**
      * @brief Rimuove l'ultimo elemento dal vettore.
      *
+     * Può ridurre la capacità secondo `GrowthPolicy::shrink`.
+     *
      * @throws std::out_of_range se il vettore è vuoto.
      */
     void pop_back();
@@ -94,6 +396,41 @@ namespace zkl
      */
     const T& operator[](size_t index) const;
 
+    /**
+     * @brief Restituisce il puntatore al primo elemento; gli elementi sono contigui.
+     *
+     * @return Puntatore ai dati, valido fino alla prossima riallocazione.
+     */
+    T* data() noexcept;
+
+    /**
+     * @brief Restituisce il puntatore al primo elemento (versione const).
+     *
+     * @return Puntatore costante ai dati.
+     */
+    const T* data() const noexcept;
+
+    /**
+     * @brief Restituisce un iteratore al primo elemento.
+     *
+     * Gli iteratori sono puntatori, quindi contigui e utilizzabili con `<algorithm>` e `zkl::parallel`.
+     * Ogni riallocazione li invalida.
+     *
+     * @return Iteratore al primo elemento.
+     */
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+
+    /**
+     * @brief Restituisce un iteratore oltre l'ultimo elemento.
+     *
+     * @return Iteratore oltre l'ultimo elemento.
+     */
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
     /**
      * @brief Restituisce il numero corrente di elementi nel vettore.
      *
@@ -118,7 +455,7 @@ namespace zkl
     /**
      * @brief Rimuove tutti gli elementi dal vettore senza modificare la capacità.
      */
-    void clear() const;
+    void clear() noexcept;
 
     /**
      * @brief Riserva una capacità minima per il vettore.
@@ -128,635 +465,4301 @@ namespace zkl
      * @param newCapacity La nuova capacità desiderata.
      */
     void reserve(size_t newCapacity);
+
+    /**
+     * @brief Riduce la capacità al numero di elementi, liberando la memoria inutilizzata.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Cambia il numero di elementi del vettore.
+     *
+     * Gli elementi aggiunti sono inizializzati per valore; quelli in eccesso vengono distrutti.
+     *
+     * @param newSize Il nuovo numero di elementi.
+     */
+    void resize(size_t newSize);
+
+    /**
+     * @brief Scambia il contenuto con un altro vettore senza copiare gli elementi.
+     *
+     * @param other Il vettore con cui scambiare il contenuto.
+     */
+    void swap(vector& other) noexcept;
   };
 
+  namespace pmr
+  {
+    /**
+     * @brief `zkl::vector` che alloca tramite una `std::pmr::memory_resource`, come `std::pmr::vector`.
+     */
+    template <typename T, typename GrowthPolicy = growth_policy<>>
+    using vector = zkl::vector<T, GrowthPolicy, std::pmr::polymorphic_allocator<T>>;
+  } // namespace pmr
+
   /**
-   * @brief Classe che implementa una stringa dinamica simile a std::string.
+   * @brief Vettore dinamico che contiene fino a `N` elementi all'interno dell'oggetto.
+   *
+   * Ha la stessa interfaccia di `zkl::vector`: finché la dimensione non supera `N` gli elementi
+   * stanno in un buffer interno e non viene allocata memoria; oltre, passano in un array ottenuto
+   * da `Allocator` e crescono secondo `GrowthPolicy`. Quando `pop_back` o `shrink_to_fit` riducono
+   * la capacità a `N` o meno, gli elementi tornano nel buffer interno.
+   *
+   * A differenza di `zkl::vector`, lo spostamento di un vettore con gli elementi interni sposta gli
+   * elementi uno per uno, quindi invalida i riferimenti e costa O(N).
+   *
+   * @tparam T Il tipo di elementi memorizzati nel vettore.
+   * @tparam N Il numero di elementi contenuti senza allocare (almeno 1).
+   * @tparam GrowthPolicy La politica di crescita e riduzione della capacità (vedi `growth_policy`).
+   * @tparam Allocator L'allocatore della memoria oltre il buffer interno.
    */
-  class string
+  template <typename T, size_t N, typename GrowthPolicy = growth_policy<>, typename Allocator = std::allocator<T>>
+  class small_vector
   {
   public:
-    /** Valore costante che rappresenta la posizione non valida. */
-    static const size_t npos = -1;
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+  private:
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    static_assert(N > 0, "small_vector needs room for at least one element");
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+
+    T* _array;                                       /**< Il buffer interno o un array allocato; solo i primi `_size` elementi sono costruiti. */
+    size_t _size;                                    /**< Numero corrente di elementi nel vettore. */
+    size_t _capacity;                                /**< Capacità corrente: `N` finché gli elementi sono interni. */
+    Allocator _allocator;                            /**< Allocatore della memoria e degli elementi. */
+    alignas(T) unsigned char _inline[N * sizeof(T)]; /**< Buffer interno non inizializzato per `N` elementi. */
 
     /**
-     * @brief Costruttore di default. Inizializza una stringa vuota.
+     * @brief Restituisce il buffer interno.
      */
-    string();
+    T* inline_data() noexcept;
 
     /**
-     * @brief Costruttore che inizializza la stringa con una stringa C.
-     *
-     * @param string Puntatore a una stringa C (null-terminated).
+     * @brief Verifica se gli elementi si trovano nel buffer interno.
      */
-    string(const char* string);
+    bool is_inline() const noexcept;
 
     /**
-     * @brief Costruttore di copia. Crea una nuova stringa come copia di un'altra.
-     *
-     * @param other Riferimento costante all'altra stringa da copiare.
+     * @brief Alloca memoria non inizializzata per `count` elementi.
      */
-    string(const string& other);
+    T* allocate(size_t count);
 
     /**
-     * @brief Costruttore di spostamento. Inizializza la stringa trasferendo le risorse da un'altra stringa.
+     * @brief Libera `array` se non è il buffer interno, senza distruggere elementi.
      *
-     * @param other Riferimento a rvalue di un'altra stringa.
+     * @param array La memoria da liberare.
+     * @param count Il numero di elementi per cui era stata allocata.
      */
-    string(string&& other) noexcept;
+    void deallocate(T* array, size_t count) noexcept;
 
     /**
-     * @brief Distruttore. Libera la memoria allocata per i dati della stringa.
+     * @brief Distrugge gli elementi di `array[0, count)`.
      */
-    ~string();
+    void destroy(T* array, size_t count) noexcept;
 
     /**
-     * @brief Operatore di assegnazione di copia. Assegna il contenuto di un'altra stringa.
+     * @brief Trasferisce `count` elementi da `from` alla memoria non inizializzata `to`.
      *
-     * @param other Riferimento costante all'altra stringa da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * Come in `zkl::vector`: memcpy per i tipi banalmente copiabili, altrimenti spostamento se è
+     * `noexcept` o copia; se una copia lancia un'eccezione `from` resta intatto.
      */
-    string& operator=(const string& other);
+    void relocate(T* from, size_t count, T* to);
 
     /**
-     * @brief Operatore di assegnazione di spostamento. Assegna il contenuto di una stringa rvalue trasferendo le risorse.
+     * @brief Rialloca gli elementi a una nuova capacità.
      *
-     * @param other Riferimento a rvalue di un'altra stringa.
-     * @return Riferimento alla stringa assegnata.
+     * Una capacità di `N` o meno riporta gli elementi nel buffer interno.
+     *
+     * @param newCapacity La nuova capacità desiderata, almeno pari a `_size`.
      */
-    string& operator=(string&& other) noexcept;
+    void reallocate(size_t newCapacity);
 
     /**
-     * @brief Operatore di estrazione da flusso di input.
+     * @brief Distrugge gli elementi, libera l'array e prende il contenuto di `other`, che rimane vuoto.
      *
-     * @param is Riferimento al flusso di input.
-     * @param str Riferimento alla stringa da riempire.
-     * @return Riferimento al flusso di input.
+     * Un array allocato passa senza toccare gli elementi; quelli interni vengono spostati.
      */
-    friend std::istream& operator>>(std::istream& is, string& str);
+    void steal(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value);
 
+  public:
     /**
-     * @brief Operatore di inserimento in flusso di output.
-     *
-     * @param os Riferimento al flusso di output.
-     * @param str Riferimento costante alla stringa da inserire.
-     * @return Riferimento al flusso di output.
+     * @brief Costruttore di default. Inizializza un vettore vuoto senza allocare.
      */
-    friend std::ostream& operator<<(std::ostream& os, const string& str);
+    small_vector();
 
     /**
-     * @brief Restituisce la dimensione della stringa.
+     * @brief Costruisce un vettore vuoto che userà l'allocatore specificato.
      *
-     * @return Numero di caratteri nella stringa.
+     * @param allocator L'allocatore da usare.
      */
-    size_t size() const;
+    explicit small_vector(const Allocator& allocator);
 
     /**
-     * @brief Restituisce la lunghezza della stringa.
+     * @brief Costruttore che inizializza il vettore con una capacità iniziale specificata.
      *
-     * @return Numero di caratteri nella stringa.
+     * Alloca memoria solo se `initialCapacity` supera `N`; non costruisce alcun elemento.
+     *
+     * @param initialCapacity La capacità iniziale del vettore.
+     * @param allocator L'allocatore da usare.
      */
-    size_t length() const;
+    small_vector(size_t initialCapacity, const Allocator& allocator = Allocator());
 
     /**
-     * @brief Cancella il contenuto della stringa, rendendola vuota.
+     * @brief Costruttore di copia. Copia tutti gli elementi.
+     *
+     * L'allocatore è scelto da `select_on_container_copy_construction`.
+     *
+     * @param other Il vettore da copiare.
      */
-    void clear();
+    small_vector(const small_vector& other);
 
     /**
-     * @brief Verifica se la stringa è vuota.
+     * @brief Costruttore di copia con un allocatore specificato.
      *
-     * @return `true` se la stringa è vuota, `false` altrimenti.
+     * @param other Il vettore da copiare.
+     * @param allocator L'allocatore della copia.
      */
-    bool empty() const;
+    small_vector(const small_vector& other, const Allocator& allocator);
 
     /**
-     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti.
+     * @brief Costruttore di spostamento.
      *
-     * @param index L'indice del carattere da accedere.
-     * @return Riferimento al carattere all'indice specificato.
+     * Un array allocato viene trasferito senza toccare gli elementi; gli elementi interni vengono spostati.
+     *
+     * @param other Il vettore da spostare, che rimane vuoto.
      */
-    char& operator[](const size_t index);
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
 
     /**
-     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti (versione const).
-     *
-     * @param index L'indice del carattere da accedere.
-     * @return Riferimento costante al carattere all'indice specificato.
+     * @brief Distruttore. Distrugge gli elementi e libera l'eventuale array allocato.
      */
-    const char& operator[](const size_t index) const;
+    ~small_vector();
 
     /**
-     * @brief Accede al carattere al indice specificato con controllo dei limiti.
+     * @brief Operatore di assegnazione di copia.
      *
-     * @param index L'indice del carattere da accedere.
-     * @return Riferimento al carattere all'indice specificato.
-     *
-     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     * @param other Il vettore da copiare.
+     * @return Riferimento al vettore assegnato.
      */
-    char& at(const size_t index);
+    small_vector& operator=(const small_vector& other);
 
     /**
-     * @brief Accede al carattere al indice specificato con controllo dei limiti (versione const).
+     * @brief Operatore di assegnazione di spostamento.
      *
-     * @param index L'indice del carattere da accedere.
-     * @return Riferimento costante al carattere all'indice specificato.
+     * Se l'allocatore non si propaga ed è diverso da quello di `other`, gli elementi vengono spostati
+     * uno alla volta nella memoria di questo vettore.
      *
-     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     * @param other Il vettore da spostare, che rimane vuoto.
+     * @return Riferimento al vettore assegnato.
      */
-    const char& at(const size_t index) const;
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value));
 
     /**
-     * @brief Restituisce una referenza al primo carattere della stringa.
+     * @brief Restituisce una copia dell'allocatore.
      *
-     * @return Riferimento al primo carattere.
+     * @return L'allocatore del vettore.
      */
-    char& front();
+    Allocator get_allocator() const;
 
     /**
-     * @brief Restituisce una referenza all'ultimo carattere della stringa.
+     * @brief Aggiunge un elemento alla fine del vettore.
      *
-     * @return Riferimento all'ultimo carattere.
+     * @param value Riferimento all'elemento da aggiungere.
      */
-    char& back();
+    void push_back(const T& value);
 
     /**
-     * @brief Restituisce una referenza costante al primo carattere della stringa.
+     * @brief Aggiunge un elemento alla fine del vettore spostandolo.
      *
-     * @return Riferimento costante al primo carattere.
+     * @param value L'elemento da spostare.
      */
-    const char& front() const;
+    void push_back(T&& value);
 
     /**
-     * @brief Restituisce una referenza costante all'ultimo carattere della stringa.
+     * @brief Costruisce un elemento direttamente alla fine del vettore.
      *
-     * @return Riferimento costante all'ultimo carattere.
+     * @param args Gli argomenti del costruttore di `T`.
+     * @return Riferimento all'elemento costruito.
      */
-    const char& back() const;
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
 
     /**
-     * @brief Aggiunge una stringa alla fine di questa stringa.
+     * @brief Rimuove l'ultimo elemento dal vettore.
      *
-     * @param other La stringa da aggiungere.
+     * Può ridurre la capacità secondo `GrowthPolicy::shrink`, fino a tornare nel buffer interno.
+     *
+     * @throws std::out_of_range se il vettore è vuoto.
+     */
+    void pop_back();
+
+    /**
+     * @brief Accede all'elemento al indice specificato con controllo dei limiti.
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento all'elemento al indice specificato.
+     *
+     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     */
+    T& at(size_t index);
+
+    /**
+     * @brief Accede all'elemento al indice specificato con controllo dei limiti (versione const).
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento costante all'elemento al indice specificato.
+     *
+     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     */
+    const T& at(size_t index) const;
+
+    /**
+     * @brief Accede all'elemento al indice specificato senza controllo dei limiti.
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento all'elemento al indice specificato.
+     */
+    T& operator[](size_t index);
+
+    /**
+     * @brief Accede all'elemento al indice specificato senza controllo dei limiti (versione const).
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento costante all'elemento al indice specificato.
+     */
+    const T& operator[](size_t index) const;
+
+    /**
+     * @brief Restituisce il puntatore al primo elemento; gli elementi sono contigui.
+     *
+     * @return Puntatore ai dati, valido fino alla prossima riallocazione.
+     */
+    T* data() noexcept;
+
+    /**
+     * @brief Restituisce il puntatore al primo elemento (versione const).
+     *
+     * @return Puntatore costante ai dati.
+     */
+    const T* data() const noexcept;
+
+    /**
+     * @brief Restituisce un iteratore al primo elemento.
+     *
+     * Gli iteratori sono puntatori, quindi contigui e utilizzabili con `<algorithm>` e `zkl::parallel`.
+     * Ogni riallocazione li invalida.
+     *
+     * @return Iteratore al primo elemento.
+     */
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+
+    /**
+     * @brief Restituisce un iteratore oltre l'ultimo elemento.
+     *
+     * @return Iteratore oltre l'ultimo elemento.
+     */
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    /**
+     * @brief Restituisce il numero corrente di elementi nel vettore.
+     *
+     * @return Numero di elementi.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Restituisce la capacità corrente del vettore, mai inferiore a `N`.
+     *
+     * @return Capacità del vettore.
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Verifica se il vettore è vuoto.
+     *
+     * @return `true` se il vettore è vuoto, `false` altrimenti.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Rimuove tutti gli elementi dal vettore senza modificare la capacità.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Riserva una capacità minima per il vettore.
+     *
+     * @param newCapacity La nuova capacità desiderata.
+     */
+    void reserve(size_t newCapacity);
+
+    /**
+     * @brief Riduce la capacità al numero di elementi (o a `N`), liberando la memoria inutilizzata.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Cambia il numero di elementi del vettore.
+     *
+     * Gli elementi aggiunti sono inizializzati per valore; quelli in eccesso vengono distrutti.
+     *
+     * @param newSize Il nuovo numero di elementi.
+     */
+    void resize(size_t newSize);
+
+    /**
+     * @brief Scambia il contenuto con un altro vettore.
+     *
+     * Gli array allocati vengono scambiati senza copiare; gli elementi interni vengono spostati.
+     *
+     * @param other Il vettore con cui scambiare il contenuto.
+     */
+    void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_swappable<T>::value);
+  };
+
+  /**
+   * @brief Vettore a segmenti in cui più thread possono aggiungere elementi contemporaneamente.
+   *
+   * Ogni `push_back` riserva un indice con un incremento atomico e costruisce l'elemento nel suo
+   * segmento senza lock: il segmento k contiene il doppio degli elementi del precedente e viene
+   * allocato dal primo thread che ne ha bisogno. I segmenti non vengono mai spostati, quindi
+   * riferimenti, puntatori e indici restano validi per tutta la vita del vettore.
+   *
+   * Lettura concorrente: `at()` e gli iteratori sono sicuri anche mentre altri thread aggiungono
+   * elementi, perché visitano solo gli elementi già costruiti. `operator[]` non fa controlli: un
+   * elemento si può leggere così solo se il suo `push_back` è avvenuto prima (nello stesso thread
+   * o dopo una sincronizzazione, ad esempio `join()`).
+   * Se l'allocazione o il costruttore di un elemento lanciano un'eccezione il suo indice resta
+   * vuoto: `size()` non lo conta e gli iteratori lo saltano, quindi dopo un errore gli indici non
+   * sono più contigui.
+   *
+   * `clear()`, la distruzione e lo spostamento non sono thread-safe.
+   *
+   * @tparam T Il tipo di elementi memorizzati nel vettore.
+   */
+  template <typename T>
+  class concurrent_vector
+  {
+  public:
+    typedef T value_type;
+
+    /**
+     * @brief Iteratore in avanti sugli elementi costruiti, in ordine di indice.
+     *
+     * Salta gli indici vuoti (elementi ancora in costruzione o il cui `push_back` ha lanciato
+     * un'eccezione) e si ferma al primo indice non ancora riservato, quindi può essere usato mentre
+     * altri thread aggiungono elementi.
+     *
+     * @tparam Const `true` per l'iteratore costante.
+     */
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef typename std::conditional<Const, const T*, T*>::type pointer;
+      typedef typename std::conditional<Const, const T&, T&>::type reference;
+      typedef typename std::conditional<Const, const concurrent_vector*, concurrent_vector*>::type owner_pointer;
+
+      /**
+       * @brief Costruttore di default. Crea un iteratore non associato ad alcun vettore.
+       */
+      basic_iterator() noexcept;
+
+      /**
+       * @brief Conversione da iteratore modificabile a iteratore costante.
+       */
+      template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+      basic_iterator(const basic_iterator<OtherConst>& other) noexcept;
+
+      reference operator*() const noexcept;
+      pointer operator->() const noexcept;
+      basic_iterator& operator++() noexcept;
+      basic_iterator operator++(int) noexcept;
+
+      bool operator==(const basic_iterator& other) const noexcept;
+      bool operator!=(const basic_iterator& other) const noexcept;
+
+    private:
+      friend class concurrent_vector;
+
+      template <bool>
+      friend class basic_iterator;
+
+      basic_iterator(owner_pointer owner, size_t index) noexcept;
+
+      /**
+       * @brief Avanza fino al primo elemento costruito, o diventa l'iteratore di fine se non ce ne sono.
+       */
+      void skip_empty() noexcept;
+
+      owner_pointer _owner; /**< Il vettore percorso. */
+      size_t _index;        /**< Indice dell'elemento corrente; `_endIndex` per l'iteratore di fine. */
+      T* _element;          /**< L'elemento corrente, letto una volta sola quando l'iteratore vi si ferma. */
+    };
+
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    /**
+     * @brief Costruttore di default. Crea un vettore vuoto senza allocare.
+     */
+    concurrent_vector() noexcept;
+
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    /**
+     * @brief Costruttore di spostamento. Trasferisce i segmenti; non è thread-safe.
+     *
+     * @param other Il vettore da spostare, che rimane vuoto.
+     */
+    concurrent_vector(concurrent_vector&& other) noexcept;
+
+    /**
+     * @brief Distruttore. Distrugge gli elementi costruiti e libera i segmenti.
+     */
+    ~concurrent_vector();
+
+    /**
+     * @brief Aggiunge un elemento alla fine del vettore. Thread-safe.
+     *
+     * L'indice viene riservato prima di allocare il segmento e costruire l'elemento: se uno dei due
+     * passi lancia un'eccezione l'indice resta vuoto, non viene contato da `size()` e gli iteratori lo saltano.
+     *
+     * @param value Riferimento all'elemento da aggiungere.
+     * @return L'indice dell'elemento.
+     */
+    size_t push_back(const T& value);
+
+    /**
+     * @brief Aggiunge un elemento alla fine del vettore spostandolo. Thread-safe.
+     *
+     * Se lancia un'eccezione lascia un indice vuoto, come `push_back(const T&)`.
+     *
+     * @param value L'elemento da spostare.
+     * @return L'indice dell'elemento.
+     */
+    size_t push_back(T&& value);
+
+    /**
+     * @brief Costruisce un elemento alla fine del vettore. Thread-safe.
+     *
+     * Se lancia un'eccezione lascia un indice vuoto, come `push_back(const T&)`.
+     *
+     * @param args Gli argomenti del costruttore di `T`.
+     * @return Riferimento all'elemento costruito, valido per tutta la vita del vettore.
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    /**
+     * @brief Accede a un elemento già costruito con controllo dei limiti. Thread-safe.
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento all'elemento.
+     *
+     * @throws std::out_of_range se l'indice non è ancora stato riservato o l'elemento non è ancora (o non è stato) costruito.
+     */
+    T& at(size_t index);
+
+    /**
+     * @brief Accede a un elemento già costruito con controllo dei limiti (versione const). Thread-safe.
+     *
+     * @param index L'indice dell'elemento da accedere.
+     * @return Riferimento costante all'elemento.
+     *
+     * @throws std::out_of_range se l'indice non è ancora stato riservato o l'elemento non è ancora (o non è stato) costruito.
+     */
+    const T& at(size_t index) const;
+
+    /**
+     * @brief Accede a un elemento senza controlli.
+     *
+     * @param index Un indice restituito da un `push_back` avvenuto prima.
+     * @return Riferimento all'elemento.
+     */
+    T& operator[](size_t index) noexcept;
+
+    /**
+     * @brief Accede a un elemento senza controlli (versione const).
+     *
+     * @param index Un indice restituito da un `push_back` avvenuto prima.
+     * @return Riferimento costante all'elemento.
+     */
+    const T& operator[](size_t index) const noexcept;
+
+    /**
+     * @brief Restituisce il numero di elementi, compresi quelli ancora in costruzione.
+     *
+     * Non conta gli indici rimasti vuoti perché il loro `push_back` ha lanciato un'eccezione: dopo un
+     * errore l'ultimo indice usato può superare `size() - 1`, quindi per visitare tutti gli elementi
+     * usare gli iteratori.
+     *
+     * @return Numero di elementi.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Verifica se il vettore è vuoto.
+     *
+     * @return `true` se il vettore non contiene elementi, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Restituisce il numero di elementi contenuti dai segmenti già allocati.
+     *
+     * @return Capacità del vettore.
+     */
+    size_t capacity() const noexcept;
+
+    /**
+     * @brief Restituisce il numero massimo di elementi.
+     *
+     * @return La somma delle dimensioni di tutti i segmenti.
+     */
+    static constexpr size_t max_size() noexcept;
+
+    /**
+     * @brief Alloca in anticipo i segmenti necessari per `newCapacity` elementi. Thread-safe.
+     *
+     * @param newCapacity La capacità desiderata.
+     *
+     * @throws std::length_error se `newCapacity` supera `max_size()`.
+     */
+    void reserve(size_t newCapacity);
+
+    /**
+     * @brief Distrugge tutti gli elementi mantenendo i segmenti. Non è thread-safe.
+     */
+    void clear() noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+  private:
+    /** Numero di elementi del primo segmento; ogni segmento successivo raddoppia. */
+    static const size_t _firstSegment = 64;
+
+    /** Numero massimo di segmenti. */
+    static const size_t _segmentCount = 40;
+
+    /** Indice dell'iteratore di fine, oltre qualsiasi indice valido. */
+    static const size_t _endIndex = ~size_t(0);
+
+    std::atomic<T*> _segments[_segmentCount]; /**< Segmenti allocati, seguiti dai loro byte di stato; `nullptr` se non ancora allocati. */
+    alignas(64) std::atomic<size_t> _size;    /**< Prossimo indice da riservare, su una linea di cache propria perché è conteso. */
+    std::atomic<size_t> _failed;              /**< Indici riservati rimasti vuoti perché la costruzione ha lanciato un'eccezione. */
+
+    /**
+     * @brief Restituisce il numero di indici riservati, senza quelli oltre `max_size()`.
+     */
+    size_t reserved() const noexcept;
+
+    /**
+     * @brief Restituisce il segmento che contiene un indice.
+     */
+    static size_t segment_of(size_t index) noexcept;
+
+    /**
+     * @brief Restituisce il primo indice di un segmento.
+     */
+    static size_t segment_start(size_t segment) noexcept;
+
+    /**
+     * @brief Restituisce il numero di elementi di un segmento.
+     */
+    static size_t segment_size(size_t segment) noexcept;
+
+    /**
+     * @brief Restituisce il numero di `T` da allocare per un segmento, compreso lo spazio per i byte di stato.
+     */
+    static size_t segment_allocation(size_t segment) noexcept;
+
+    /**
+     * @brief Restituisce i byte di stato (1 = costruito) degli elementi di un segmento allocato.
+     */
+    static std::atomic<uint8_t>* ready_flags(T* data, size_t segment) noexcept;
+
+    /**
+     * @brief Restituisce un segmento, allocandolo se nessun thread l'ha ancora fatto.
+     */
+    T* acquire_segment(size_t segment);
+
+    /**
+     * @brief Restituisce l'elemento con l'indice specificato, o `nullptr` se non è costruito.
+     */
+    T* constructed(size_t index) const noexcept;
+
+    /**
+     * @brief Riserva il prossimo indice e vi costruisce un elemento.
+     *
+     * @return L'indice dell'elemento.
+     */
+    template <typename... Args>
+    size_t construct_next(Args&&... args);
+  };
+
+  namespace detail
+  {
+    /** Dimensione di una linea di cache: i contatori scritti da thread diversi stanno su linee diverse. */
+    const size_t cache_line = 64;
+
+    /**
+     * @brief Arrotonda una capacità alla potenza di 2 successiva (almeno 2).
+     *
+     * @throws std::length_error se la capacità non è rappresentabile.
+     */
+    size_t ring_capacity(size_t capacity);
+  } // namespace detail
+
+  /**
+   * @brief Coda circolare a capacità fissa per un solo produttore e un solo consumatore, senza lock.
+   *
+   * La capacità è una potenza di 2 e la memoria è allocata una volta sola da `Allocator`, come in
+   * `zkl::vector`: gli elementi vengono costruiti all'inserimento e distrutti all'estrazione.
+   * Produttore e consumatore pubblicano la propria posizione con un solo store atomico e tengono
+   * una copia locale della posizione dell'altro, che rileggono solo quando la coda sembra piena o
+   * vuota. Le due posizioni stanno su linee di cache separate.
+   *
+   * `try_push`, `try_emplace` e `push_n` vanno chiamati da un solo thread alla volta, così come
+   * `try_pop` e `pop_n`; le operazioni batch pubblicano tutti gli elementi con un solo store.
+   *
+   * @tparam T Il tipo di elementi nella coda.
+   * @tparam Allocator L'allocatore della memoria degli elementi.
+   */
+  template <typename T, typename Allocator = std::allocator<T>>
+  class spsc_ring
+  {
+  public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+
+    /**
+     * @brief Crea una coda vuota.
+     *
+     * @param capacity Numero minimo di elementi, arrotondato alla potenza di 2 successiva.
+     * @param allocator L'allocatore da usare.
+     */
+    explicit spsc_ring(size_t capacity, const Allocator& allocator = Allocator());
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    /**
+     * @brief Distruttore. Distrugge gli elementi ancora in coda e libera la memoria.
+     */
+    ~spsc_ring();
+
+    /**
+     * @brief Inserisce una copia di un elemento se c'è posto. Solo produttore.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena.
+     */
+    bool try_push(const T& value);
+
+    /**
+     * @brief Inserisce un elemento spostandolo se c'è posto. Solo produttore.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena (e `value` non è stato toccato).
+     */
+    bool try_push(T&& value);
+
+    /**
+     * @brief Costruisce un elemento in coda se c'è posto. Solo produttore.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena.
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    /**
+     * @brief Inserisce fino a `count` elementi copiandoli da `first`. Solo produttore.
+     *
+     * @param first Iteratore al primo elemento da inserire.
+     * @param count Numero di elementi disponibili.
+     * @return Numero di elementi inseriti, minore di `count` se la coda si è riempita.
+     */
+    template <typename InputIt>
+    size_t push_n(InputIt first, size_t count);
+
+    /**
+     * @brief Estrae l'elemento più vecchio. Solo consumatore.
+     *
+     * @param out Riceve l'elemento per spostamento.
+     * @return `true` se un elemento è stato estratto, `false` se la coda è vuota.
+     */
+    bool try_pop(T& out);
+
+    /**
+     * @brief Estrae fino a `count` elementi spostandoli in `out`. Solo consumatore.
+     *
+     * @param out Iteratore di output che riceve gli elementi in ordine.
+     * @param count Numero massimo di elementi da estrarre.
+     * @return Numero di elementi estratti.
+     */
+    template <typename OutputIt>
+    size_t pop_n(OutputIt out, size_t count);
+
+    /**
+     * @brief Restituisce il numero di elementi in coda; approssimativo se l'altro thread sta lavorando.
+     *
+     * @return Numero di elementi.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Verifica se la coda è vuota (approssimativo come `size()`).
+     *
+     * @return `true` se la coda è vuota, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Restituisce la capacità della coda.
+     *
+     * @return Numero massimo di elementi, una potenza di 2.
+     */
+    size_t capacity() const noexcept;
+
+  private:
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+
+    T* _slots;            /**< Memoria non inizializzata per `_mask + 1` elementi. */
+    size_t _mask;         /**< Capacità - 1, per ridurre le posizioni a indici. */
+    Allocator _allocator; /**< Allocatore della memoria e degli elementi. */
+
+    alignas(detail::cache_line) std::atomic<size_t> _tail; /**< Prossima posizione da scrivere; la scrive solo il produttore. */
+    size_t _cachedHead;                                    /**< Ultima `_head` letta dal produttore. */
+
+    alignas(detail::cache_line) std::atomic<size_t> _head; /**< Prossima posizione da leggere; la scrive solo il consumatore. */
+    size_t _cachedTail;                                    /**< Ultima `_tail` letta dal consumatore. */
+
+    char _padding[detail::cache_line - sizeof(std::atomic<size_t>) - sizeof(size_t)]; /**< Separa `_head` dagli oggetti che seguono. */
+
+    /**
+     * @brief Restituisce quanti posti liberi vede il produttore, rileggendo `_head` solo se servono più posti.
+     */
+    size_t free_slots(size_t tail, size_t wanted) noexcept;
+
+    /**
+     * @brief Restituisce quanti elementi vede il consumatore, rileggendo `_tail` solo se ne servono di più.
+     */
+    size_t ready_slots(size_t head, size_t wanted) noexcept;
+  };
+
+  /**
+   * @brief Coda circolare a capacità fissa per più produttori e più consumatori, senza lock.
+   *
+   * Ogni cella ha un numero di sequenza che dice a produttori e consumatori se è libera o piena
+   * per il giro corrente (schema di Vyukov): un inserimento o un'estrazione costa un solo CAS sulla
+   * posizione condivisa e nessun thread aspetta gli altri, salvo quando la coda è piena o vuota.
+   * `push_n` e `pop_n` riservano più celle consecutive con un solo CAS.
+   * Come `spsc_ring` la capacità è una potenza di 2, la memoria è allocata una volta sola da
+   * `Allocator` e le due posizioni stanno su linee di cache separate. Lo spostamento di `T` non
+   * deve lanciare eccezioni.
+   *
+   * @tparam T Il tipo di elementi nella coda.
+   * @tparam Allocator L'allocatore della memoria (riassociato al tipo delle celle).
+   */
+  template <typename T, typename Allocator = std::allocator<T>>
+  class mpmc_ring
+  {
+  public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+
+    /**
+     * @brief Crea una coda vuota.
+     *
+     * @param capacity Numero minimo di elementi, arrotondato alla potenza di 2 successiva.
+     * @param allocator L'allocatore da usare.
+     */
+    explicit mpmc_ring(size_t capacity, const Allocator& allocator = Allocator());
+
+    mpmc_ring(const mpmc_ring&) = delete;
+    mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+    /**
+     * @brief Distruttore. Distrugge gli elementi ancora in coda e libera la memoria.
+     */
+    ~mpmc_ring();
+
+    /**
+     * @brief Inserisce una copia di un elemento se c'è posto. Thread-safe.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena.
+     */
+    bool try_push(const T& value);
+
+    /**
+     * @brief Inserisce un elemento spostandolo se c'è posto. Thread-safe.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena (e `value` non è stato toccato).
+     */
+    bool try_push(T&& value);
+
+    /**
+     * @brief Costruisce un elemento in coda se c'è posto. Thread-safe.
+     *
+     * Se il costruttore può lanciare eccezioni l'elemento viene costruito prima di riservare la
+     * cella e poi spostato, perché una cella riservata deve sempre essere pubblicata.
+     *
+     * @return `true` se l'elemento è stato inserito, `false` se la coda è piena.
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    /**
+     * @brief Inserisce fino a `count` elementi copiandoli da `first`, riservando le celle con un solo CAS. Thread-safe.
+     *
+     * Gli elementi inseriti da una chiamata occupano posizioni consecutive.
+     *
+     * @param first Iteratore al primo elemento da inserire.
+     * @param count Numero di elementi disponibili.
+     * @return Numero di elementi inseriti, minore di `count` se la coda si è riempita.
+     */
+    template <typename InputIt>
+    size_t push_n(InputIt first, size_t count);
+
+    /**
+     * @brief Estrae l'elemento più vecchio. Thread-safe.
+     *
+     * @param out Riceve l'elemento per spostamento.
+     * @return `true` se un elemento è stato estratto, `false` se la coda è vuota.
+     */
+    bool try_pop(T& out);
+
+    /**
+     * @brief Estrae fino a `count` elementi consecutivi spostandoli in `out`, con un solo CAS. Thread-safe.
+     *
+     * @param out Iteratore di output che riceve gli elementi in ordine.
+     * @param count Numero massimo di elementi da estrarre.
+     * @return Numero di elementi estratti.
+     */
+    template <typename OutputIt>
+    size_t pop_n(OutputIt out, size_t count);
+
+    /**
+     * @brief Restituisce il numero di elementi in coda, approssimativo mentre altri thread lavorano.
+     *
+     * @return Numero di elementi.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Verifica se la coda è vuota (approssimativo come `size()`).
+     *
+     * @return `true` se la coda è vuota, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Restituisce la capacità della coda.
+     *
+     * @return Numero massimo di elementi, una potenza di 2.
+     */
+    size_t capacity() const noexcept;
+
+  private:
+    /**
+     * @brief Una cella: numero di sequenza e spazio per un elemento.
+     *
+     * La cella della posizione p è libera per il produttore quando `sequence == p` e piena per il
+     * consumatore quando `sequence == p + 1`; estraendo diventa `p + capacità`, libera per il giro dopo.
+     */
+    struct cell
+    {
+      std::atomic<size_t> sequence;                /**< Numero di sequenza della cella. */
+      alignas(T) unsigned char storage[sizeof(T)]; /**< Spazio non inizializzato per l'elemento. */
+    };
+
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<cell> cell_allocator;
+    typedef std::allocator_traits<cell_allocator> cell_traits;
+
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value, "Allocator::value_type must be T");
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value, "mpmc_ring requires a noexcept move");
+
+    cell* _cells;         /**< Le celle della coda. */
+    size_t _mask;         /**< Capacità - 1, per ridurre le posizioni a indici. */
+    Allocator _allocator; /**< Allocatore degli elementi. */
+
+    alignas(detail::cache_line) std::atomic<size_t> _tail; /**< Prossima posizione da riservare per un inserimento. */
+    alignas(detail::cache_line) std::atomic<size_t> _head; /**< Prossima posizione da riservare per un'estrazione. */
+
+    char _padding[detail::cache_line - sizeof(std::atomic<size_t>)]; /**< Separa `_head` dagli oggetti che seguono. */
+
+    /**
+     * @brief Restituisce l'elemento di una cella.
+     */
+    static T* element(cell& c) noexcept;
+
+    /**
+     * @brief Riserva fino a `count` celle consecutive libere per l'inserimento.
+     *
+     * @param count Numero massimo di celle.
+     * @param[out] first Prima posizione riservata.
+     * @return Numero di celle riservate, 0 se la coda è piena.
+     */
+    size_t claim_push(size_t count, size_t& first) noexcept;
+
+    /**
+     * @brief Riserva fino a `count` celle consecutive piene per l'estrazione.
+     *
+     * @param count Numero massimo di celle.
+     * @param[out] first Prima posizione riservata.
+     * @return Numero di celle riservate, 0 se la coda è vuota.
+     */
+    size_t claim_pop(size_t count, size_t& first) noexcept;
+  };
+
+  /**
+   * @brief Risorsa di memoria monotona: alloca spostando un puntatore e libera tutto in una volta.
+   *
+   * Ogni allocazione costa un allineamento e un confronto; `deallocate` non fa nulla e la memoria
+   * torna disponibile solo con `release()` o alla distruzione dell'arena. È pensata per i dati
+   * temporanei di una richiesta: si crea un'arena all'inizio, le si collegano i contenitori con
+   * `std::pmr::polymorphic_allocator` (ad esempio `zkl::pmr::vector`) e si distrugge alla fine.
+   * I blocchi vengono chiesti alla risorsa `upstream` con dimensione crescente geometricamente;
+   * un buffer iniziale fornito dall'utente (anche sullo stack) viene usato per primo.
+   *
+   * Non è thread-safe. Deve sopravvivere a tutti i contenitori che la usano.
+   */
+  class monotonic_arena : public std::pmr::memory_resource
+  {
+  public:
+    /**
+     * @brief Crea un'arena vuota.
+     *
+     * @param initialChunkSize Dimensione del primo blocco chiesto a `upstream`.
+     * @param upstream La risorsa da cui ottenere i blocchi.
+     */
+    explicit monotonic_arena(size_t initialChunkSize = 4096, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Crea un'arena che usa prima un buffer fornito dall'utente.
+     *
+     * @param buffer Il buffer iniziale, che deve restare valido quanto l'arena.
+     * @param size La dimensione del buffer in byte.
+     * @param upstream La risorsa da cui ottenere i blocchi successivi.
+     */
+    monotonic_arena(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    /**
+     * @brief Distruttore. Restituisce tutti i blocchi a `upstream`.
+     */
+    ~monotonic_arena() override;
+
+    /**
+     * @brief Libera in una volta tutta la memoria allocata, rendendo di nuovo disponibile il buffer iniziale.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Restituisce i byte consegnati dalle allocazioni dall'ultimo `release()`.
+     *
+     * @return Byte allocati, senza contare l'allineamento.
+     */
+    size_t bytes_allocated() const noexcept;
+
+  protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  private:
+    struct chunk;
+
+    char* _current;                       /**< Prossimo byte libero del blocco corrente. */
+    char* _end;                           /**< Fine del blocco corrente. */
+    chunk* _chunks;                       /**< Blocchi ottenuti da `_upstream`, il più recente in testa. */
+    size_t _nextChunkSize;                /**< Dimensione del prossimo blocco. */
+    size_t _initialChunkSize;             /**< Dimensione del primo blocco, ripristinata da `release()`. */
+    size_t _allocated;                    /**< Byte consegnati dall'ultimo `release()`. */
+    void* _buffer;                        /**< Buffer iniziale dell'utente, o `nullptr`. */
+    size_t _bufferSize;                   /**< Dimensione del buffer iniziale. */
+    std::pmr::memory_resource* _upstream; /**< Risorsa da cui ottenere i blocchi. */
+
+    /**
+     * @brief Ottiene un nuovo blocco abbastanza grande per `bytes` con l'allineamento richiesto e alloca da esso.
+     */
+    void* allocate_from_new_chunk(size_t bytes, size_t alignment);
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief Insieme di liste libere per classi di dimensione (potenze di 2 da 16 byte a 64 KiB).
+     *
+     * I blocchi restituiti vengono riutilizzati dalle allocazioni successive della stessa classe;
+     * le richieste più grandi o con allineamento maggiore di `alignof(std::max_align_t)` passano
+     * direttamente a `upstream`. Non è thread-safe.
+     */
+    class pool
+    {
+    public:
+      explicit pool(std::pmr::memory_resource* upstream);
+      pool(const pool&) = delete;
+      pool& operator=(const pool&) = delete;
+      ~pool();
+
+      void* allocate(size_t bytes, size_t alignment);
+      void deallocate(void* p, size_t bytes, size_t alignment) noexcept;
+
+    private:
+      struct free_block;
+      struct chunk;
+
+      static const size_t _minBlock = 16;         /**< Dimensione della classe più piccola. */
+      static const size_t _classCount = 13;       /**< Classi da 16 byte a 64 KiB. */
+      static const size_t _chunkSize = 64 * 1024; /**< Dimensione minima dei blocchi chiesti a `upstream`. */
+
+      free_block* _free[_classCount];       /**< Lista libera di ciascuna classe. */
+      chunk* _chunks;                       /**< Blocchi ottenuti da `_upstream`. */
+      std::pmr::memory_resource* _upstream; /**< Risorsa da cui ottenere i blocchi. */
+
+      /**
+       * @brief Restituisce la classe di una dimensione, o `_classCount` se va servita da `upstream`.
+       */
+      static size_t class_of(size_t bytes, size_t alignment) noexcept;
+
+      /**
+       * @brief Suddivide un nuovo blocco di `upstream` nella lista libera di una classe.
+       */
+      void refill(size_t sizeClass);
+    };
+  } // namespace detail
+
+  /**
+   * @brief Allocatore con liste libere per classi di dimensione, compatibile con `std::allocator_traits`.
+   *
+   * Le copie di un allocatore (anche tra tipi diversi, dopo un rebind) condividono lo stesso pool,
+   * che viene distrutto con l'ultima copia. La memoria liberata da un contenitore viene riutilizzata
+   * dagli altri contenitori dello stesso pool senza tornare all'heap globale; con una
+   * `monotonic_arena` come upstream anche i blocchi del pool vengono dall'arena, così tutto
+   * si libera insieme a fine richiesta. Non è thread-safe.
+   *
+   * @tparam T Il tipo degli elementi allocati.
+   */
+  template <typename T>
+  class pool_allocator
+  {
+  public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    /**
+     * @brief Crea un allocatore con un nuovo pool che ottiene la memoria dall'heap.
+     */
+    pool_allocator();
+
+    /**
+     * @brief Crea un allocatore con un nuovo pool che ottiene la memoria da `upstream`.
+     *
+     * @param upstream La risorsa da cui ottenere i blocchi, che deve sopravvivere al pool.
+     */
+    explicit pool_allocator(std::pmr::memory_resource* upstream);
+
+    /**
+     * @brief Conversione da un allocatore di un altro tipo: condivide lo stesso pool.
+     */
+    template <typename U>
+    pool_allocator(const pool_allocator<U>& other) noexcept;
+
+    /**
+     * @brief Alloca memoria non inizializzata per `n` elementi.
+     *
+     * @throws std::bad_array_new_length se la dimensione supera `size_t`.
+     */
+    T* allocate(size_t n);
+
+    /**
+     * @brief Restituisce al pool memoria ottenuta da `allocate(n)`.
+     */
+    void deallocate(T* p, size_t n) noexcept;
+
+    template <typename U>
+    bool operator==(const pool_allocator<U>& other) const noexcept;
+
+    template <typename U>
+    bool operator!=(const pool_allocator<U>& other) const noexcept;
+
+  private:
+    template <typename U>
+    friend class pool_allocator;
+
+    std::shared_ptr<detail::pool> _pool; /**< Pool condiviso da tutte le copie. */
+  };
+
+  class char_set;
+  class hashed_string;
+  class string;
+  class string_view;
+
+  /**
+   * @brief Cosa fa `split` dei campi vuoti (due delimitatori di fila, o un delimitatore ai bordi).
+   */
+  enum class empty_fields
+  {
+    keep, /**< I campi vuoti vengono restituiti. */
+    skip  /**< I campi vuoti vengono saltati. */
+  };
+
+  namespace detail
+  {
+    struct char_delimiter;
+    struct string_delimiter;
+    struct set_delimiter;
+
+    /**
+     * @brief Aggiunge a `str` le cifre decimali di `magnitude`, precedute da '-' se `negative`.
+     *
+     * Conta prima le cifre, così le scrive direttamente nel buffer della stringa, due alla volta.
+     */
+    string& append_integer(string& str, unsigned long long magnitude, bool negative);
+  } // namespace detail
+
+  template <typename Delimiter>
+  class split_range;
+
+  /**
+   * @brief Classe che implementa una stringa dinamica simile a std::string.
+   */
+  class string
+  {
+  public:
+    /** Valore costante che rappresenta la posizione non valida. */
+    static const size_t npos = -1;
+
+    /**
+     * @brief Costruttore di default. Inizializza una stringa vuota.
+     */
+    string();
+
+    /**
+     * @brief Costruttore che inizializza la stringa con una stringa C.
+     *
+     * @param string Puntatore a una stringa C (null-terminated).
+     */
+    string(const char* string);
+
+    /**
+     * @brief Costruttore di copia. Crea una nuova stringa come copia di un'altra.
+     *
+     * @param other Riferimento costante all'altra stringa da copiare.
+     */
+    string(const string& other);
+
+    /**
+     * @brief Costruttore che copia il contenuto di una vista.
+     *
+     * @param sv La vista da copiare.
+     */
+    explicit string(string_view sv);
+
+    /**
+     * @brief Costruttore di spostamento. Inizializza la stringa trasferendo le risorse da un'altra stringa.
+     *
+     * @param other Riferimento a rvalue di un'altra stringa.
+     */
+    string(string&& other) noexcept;
+
+    /**
+     * @brief Distruttore. Libera la memoria allocata per i dati della stringa.
+     */
+    ~string();
+
+    /**
+     * @brief Operatore di assegnazione di copia. Assegna il contenuto di un'altra stringa.
+     *
+     * @param other Riferimento costante all'altra stringa da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& operator=(const string& other);
+
+    /**
+     * @brief Operatore di assegnazione di spostamento. Assegna il contenuto di una stringa rvalue trasferendo le risorse.
+     *
+     * @param other Riferimento a rvalue di un'altra stringa.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& operator=(string&& other) noexcept;
+
+    /**
+     * @brief Operatore di estrazione da flusso di input.
+     *
+     * @param is Riferimento al flusso di input.
+     * @param str Riferimento alla stringa da riempire.
+     * @return Riferimento al flusso di input.
+     */
+    friend std::istream& operator>>(std::istream& is, string& str);
+
+    /**
+     * @brief Operatore di inserimento in flusso di output.
+     *
+     * @param os Riferimento al flusso di output.
+     * @param str Riferimento costante alla stringa da inserire.
+     * @return Riferimento al flusso di output.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const string& str);
+
+    /**
+     * @brief Restituisce la dimensione della stringa.
+     *
+     * @return Numero di caratteri nella stringa.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Restituisce la lunghezza della stringa.
+     *
+     * @return Numero di caratteri nella stringa.
+     */
+    size_t length() const;
+
+    /**
+     * @brief Restituisce la capacità corrente della stringa.
+     *
+     * @return Numero di caratteri che la stringa può contenere senza riallocare.
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Riserva una capacità minima per la stringa.
+     *
+     * Se la nuova capacità specificata è maggiore della capacità attuale, la stringa viene riallocata con la nuova capacità.
+     *
+     * @param newCapacity La nuova capacità desiderata.
+     */
+    void reserve(size_t newCapacity);
+
+    /**
+     * @brief Riduce la capacità della stringa alla sua dimensione corrente.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Cancella il contenuto della stringa, rendendola vuota senza modificare la capacità.
+     */
+    void clear();
+
+    /**
+     * @brief Verifica se la stringa è vuota.
+     *
+     * @return `true` se la stringa è vuota, `false` altrimenti.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti.
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento al carattere all'indice specificato.
+     */
+    char& operator[](const size_t index);
+
+    /**
+     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti (versione const).
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento costante al carattere all'indice specificato.
+     */
+    const char& operator[](const size_t index) const;
+
+    /**
+     * @brief Accede al carattere al indice specificato con controllo dei limiti.
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento al carattere all'indice specificato.
+     *
+     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     */
+    char& at(const size_t index);
+
+    /**
+     * @brief Accede al carattere al indice specificato con controllo dei limiti (versione const).
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento costante al carattere all'indice specificato.
+     *
+     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     */
+    const char& at(const size_t index) const;
+
+    /**
+     * @brief Restituisce una referenza al primo carattere della stringa.
+     *
+     * @return Riferimento al primo carattere.
+     */
+    char& front();
+
+    /**
+     * @brief Restituisce una referenza all'ultimo carattere della stringa.
+     *
+     * @return Riferimento all'ultimo carattere.
+     */
+    char& back();
+
+    /**
+     * @brief Restituisce una referenza costante al primo carattere della stringa.
+     *
+     * @return Riferimento costante al primo carattere.
+     */
+    const char& front() const;
+
+    /**
+     * @brief Restituisce una referenza costante all'ultimo carattere della stringa.
+     *
+     * @return Riferimento costante all'ultimo carattere.
+     */
+    const char& back() const;
+
+    /**
+     * @brief Aggiunge una stringa alla fine di questa stringa.
+     *
+     * @param other La stringa da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& operator+=(const string& other);
+
+    /**
+     * @brief Aggiunge una stringa C alla fine di questa stringa.
+     *
+     * @param str La stringa C da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& operator+=(const char* str);
+
+    /**
+     * @brief Aggiunge il contenuto di una vista alla fine di questa stringa.
+     *
+     * @param sv La vista da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& operator+=(string_view sv);
+
+    /**
+     * @brief Aggiunge un carattere alla fine di questa stringa.
+     *
+     * @param c Il carattere da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& operator+=(char c);
+
+    /**
+     * @brief Concatenazione di due stringhe.
+     *
+     * @param left La stringa di sinistra.
+     * @param right La stringa di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(const string& left, const string& right);
+
+    /**
+     * @brief Concatenazione di un carattere e una stringa.
+     *
+     * @param left Il carattere di sinistra.
+     * @param right La stringa di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(char left, const string& right);
+
+    /**
+     * @brief Concatenazione di una stringa e un carattere.
+     *
+     * @param left La stringa di sinistra.
+     * @param right Il carattere di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(const string& left, char right);
+
+    /**
+     * @brief Concatenazione di una stringa e una stringa C.
+     *
+     * @param left La stringa di sinistra.
+     * @param right La stringa C di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(const string& left, const char* right);
+
+    /**
+     * @brief Concatenazione di una stringa C e una stringa.
+     *
+     * @param left La stringa C di sinistra.
+     * @param right La stringa di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(const char* left, const string& right);
+
+    /**
+     * @brief Concatenazione che riusa il buffer di una stringa temporanea di sinistra.
+     *
+     * Permette a catene come `a + b + c` di aggiungere in coda al risultato intermedio invece di
+     * copiarlo ad ogni passo. Per una sola allocazione garantita usare `zkl::concat`.
+     *
+     * @param left La stringa temporanea di sinistra, il cui buffer viene riutilizzato.
+     * @param right La stringa di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(string&& left, const string& right);
+
+    /**
+     * @brief Concatenazione che riusa il buffer di una stringa temporanea di sinistra.
+     *
+     * @param left La stringa temporanea di sinistra, il cui buffer viene riutilizzato.
+     * @param right La stringa C di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(string&& left, const char* right);
+
+    /**
+     * @brief Concatenazione che riusa il buffer di una stringa temporanea di sinistra.
+     *
+     * @param left La stringa temporanea di sinistra, il cui buffer viene riutilizzato.
+     * @param right Il carattere di destra.
+     * @return Nuova stringa risultante dalla concatenazione.
+     */
+    friend string operator+(string&& left, char right);
+
+    /**
+     * @brief Aggiunge una stringa alla fine di questa stringa.
+     *
+     * @param str La stringa da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(const string& str);
+
+    /**
+     * @brief Aggiunge una sottostringa di un'altra stringa alla fine di questa stringa.
+     *
+     * @param str La stringa da cui prendere la sottostringa.
+     * @param subpos La posizione di inizio nella stringa `str`.
+     * @param sublen La lunghezza della sottostringa da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(const string& str, size_t subpos, size_t sublen);
+
+    /**
+     * @brief Aggiunge il contenuto di una vista alla fine di questa stringa.
+     *
+     * @param sv La vista da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(string_view sv);
+
+    /**
+     * @brief Aggiunge una stringa C alla fine di questa stringa.
+     *
+     * @param str La stringa C da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(const char* str);
+
+    /**
+     * @brief Aggiunge i primi `n` caratteri di una stringa C alla fine di questa stringa.
+     *
+     * @param str La stringa C da aggiungere.
+     * @param n Il numero massimo di caratteri da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(const char* str, size_t n);
+
+    /**
+     * @brief Aggiunge `n` copie di un carattere alla fine di questa stringa.
+     *
+     * @param n Il numero di copie del carattere da aggiungere.
+     * @param c Il carattere da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append(size_t n, char c);
+
+    /**
+     * @brief Aggiunge un carattere alla fine della stringa.
+     *
+     * @param c Il carattere da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& push_back(char c);
+
+    /**
+     * @brief Assegna il contenuto di un'altra stringa a questa stringa.
+     *
+     * @param str La stringa da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(const string& str);
+
+    /**
+     * @brief Assegna una sottostringa di un'altra stringa a questa stringa.
+     *
+     * @param str La stringa da cui prendere la sottostringa.
+     * @param subpos La posizione di inizio nella stringa `str`.
+     * @param sublen La lunghezza della sottostringa da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(const string& str, size_t subpos, size_t sublen);
+
+    /**
+     * @brief Assegna il contenuto di una vista a questa stringa.
+     *
+     * @param sv La vista da assegnare. Può riferirsi a questa stringa stessa.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(string_view sv);
+
+    /**
+     * @brief Assegna una stringa C a questa stringa.
+     *
+     * @param str La stringa C da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(const char* str);
+
+    /**
+     * @brief Assegna i primi `n` caratteri di una stringa C a questa stringa.
+     *
+     * @param s La stringa C da assegnare.
+     * @param n Il numero massimo di caratteri da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(const char* s, size_t n);
+
+    /**
+     * @brief Assegna `n` copie di un carattere a questa stringa.
+     *
+     * @param n Il numero di copie del carattere da assegnare.
+     * @param c Il carattere da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    string& assign(size_t n, char c);
+
+    /**
+     * @brief Inserisce una stringa in una posizione specifica.
+     *
+     * @param pos La posizione in cui inserire la stringa.
+     * @param str La stringa da inserire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& insert(size_t pos, const string& str);
+
+    /**
+     * @brief Inserisce una stringa C in una posizione specifica.
+     *
+     * @param pos La posizione in cui inserire la stringa C.
+     * @param str La stringa C da inserire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& insert(size_t pos, const char* str);
+
+    /**
+     * @brief Inserisce esattamente `n` caratteri di un buffer in una posizione specifica.
+     *
+     * A differenza della versione con stringa C, i caratteri nulli vengono inseriti come gli altri.
+     *
+     * @param pos La posizione in cui inserire i caratteri.
+     * @param str Puntatore ai caratteri da inserire.
+     * @param n Il numero di caratteri da inserire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& insert(size_t pos, const char* str, size_t n);
+
+    /**
+     * @brief Inserisce il contenuto di una vista in una posizione specifica.
+     *
+     * @param pos La posizione in cui inserire.
+     * @param sv La vista da inserire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& insert(size_t pos, string_view sv);
+
+    /**
+     * @brief Rimuove una porzione della stringa a partire da una posizione specifica.
+     *
+     * @param pos La posizione di inizio della porzione da rimuovere.
+     * @param len La lunghezza della porzione da rimuovere. Se omesso, rimuove fino alla fine.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& erase(size_t pos, size_t len = npos);
+
+    /**
+     * @brief Sostituisce una porzione della stringa con un'altra stringa.
+     *
+     * @param pos La posizione di inizio della porzione da sostituire.
+     * @param len La lunghezza della porzione da sostituire.
+     * @param str La stringa con cui sostituire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& replace(size_t pos, size_t len, const string& str);
+
+    /**
+     * @brief Sostituisce una porzione della stringa con una stringa C.
+     *
+     * @param pos La posizione di inizio della porzione da sostituire.
+     * @param len La lunghezza della porzione da sostituire.
+     * @param str La stringa C con cui sostituire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& replace(size_t pos, size_t len, const char* str);
+
+    /**
+     * @brief Sostituisce una porzione della stringa con esattamente `n` caratteri di un buffer.
+     *
+     * A differenza della versione con stringa C, i caratteri nulli vengono copiati come gli altri.
+     *
+     * @param pos La posizione di inizio della porzione da sostituire.
+     * @param len La lunghezza della porzione da sostituire.
+     * @param str Puntatore ai caratteri con cui sostituire.
+     * @param n Il numero di caratteri con cui sostituire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& replace(size_t pos, size_t len, const char* str, size_t n);
+
+    /**
+     * @brief Sostituisce una porzione della stringa con il contenuto di una vista.
+     *
+     * @param pos La posizione di inizio della porzione da sostituire.
+     * @param len La lunghezza della porzione da sostituire.
+     * @param sv La vista con cui sostituire.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& replace(size_t pos, size_t len, string_view sv);
+
+    /**
+     * @brief Scambia il contenuto di questa stringa con un'altra.
+     *
+     * @param str La stringa con cui scambiare.
+     */
+    void swap(string& str);
+
+    /**
+     * @brief Rimuove l'ultimo carattere della stringa.
+     */
+    void pop_back();
+
+    /**
+     * @brief Restituisce un puntatore alla stringa C interna.
+     *
+     * @return Puntatore costante alla stringa C.
+     */
+    const char* c_str() const noexcept;
+
+    /**
+     * @brief Restituisce un puntatore ai dati interni della stringa.
+     *
+     * @return Puntatore costante ai dati della stringa.
+     */
+    const char* data() const noexcept;
+
+    /**
+     * @brief Copia una porzione della stringa in un buffer.
+     *
+     * @param s Puntatore al buffer di destinazione.
+     * @param len Numero massimo di caratteri da copiare.
+     * @param pos Posizione di inizio nella stringa da cui iniziare la copia.
+     * @return Numero di caratteri effettivamente copiati.
+     */
+    size_t copy(char* s, size_t len, size_t pos = 0);
+
+    /**
+     * @brief Cerca la prima occorrenza di una stringa all'interno di questa stringa.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(string_view str, size_t pos = 0) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di un carattere all'interno di questa stringa.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(char c, size_t pos = 0) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di una sottostringa all'interno di questa stringa.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @param n Numero massimo di caratteri da considerare nella stringa da cercare.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(string_view str, size_t pos, size_t n) const noexcept;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di una stringa all'interno di questa stringa.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t rfind(string_view str, size_t pos = npos) const noexcept;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di un carattere all'interno di questa stringa.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t rfind(char c, size_t pos = npos) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa stringa.
+     *
+     * @param str La stringa contenente i caratteri da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(string_view str, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima occorrenza di qualsiasi carattere appartenente a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(const char_set& set, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima occorrenza di un carattere specifico all'interno di questa stringa.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(char c, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa stringa.
+     *
+     * @param str La stringa contenente i caratteri da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(string_view str, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di qualsiasi carattere appartenente a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(const char_set& set, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di un carattere specifico all'interno di questa stringa.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(char c, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca la prima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa stringa.
+     *
+     * @param str La stringa contenente i caratteri da escludere.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(string_view str, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima posizione il cui carattere non appartiene a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(const char_set& set, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima posizione in cui un carattere specifico non si trova all'interno di questa stringa.
+     *
+     * @param c Il carattere da escludere.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(char c, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca l'ultima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa stringa.
+     *
+     * @param str La stringa contenente i caratteri da escludere.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(string_view str, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima posizione il cui carattere non appartiene a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(const char_set& set, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima posizione in cui un carattere specifico non si trova all'interno di questa stringa.
+     *
+     * @param c Il carattere da escludere.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(char c, size_t pos = npos) const;
+
+    /**
+     * @brief Divide la stringa in campi separati da un carattere, senza copiare né allocare.
+     *
+     * @param delim Il carattere delimitatore.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi; la stringa deve restare valida mentre lo si usa.
+     */
+    split_range<detail::char_delimiter> split(char delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+    /**
+     * @brief Divide la stringa in campi separati da una sequenza di caratteri, senza copiare né allocare.
+     *
+     * @param delim La sequenza delimitatrice; deve restare valida come la stringa.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi.
+     */
+    split_range<detail::string_delimiter> split(string_view delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+    /**
+     * @brief Divide la stringa in campi separati da uno qualsiasi dei caratteri di un insieme.
+     *
+     * @param delim L'insieme dei delimitatori, copiato nell'intervallo.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi.
+     */
+    split_range<detail::set_delimiter> split(const char_set& delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+    /**
+     * @brief Restituisce una sottostringa a partire da una posizione specifica e di una lunghezza specificata.
+     *
+     * @param pos La posizione di inizio della sottostringa.
+     * @param len La lunghezza della sottostringa. Se omesso, restituisce fino alla fine della stringa.
+     * @return La sottostringa risultante.
+     */
+    string substr(size_t pos = 0, size_t len = npos) const;
+
+    /**
+     * @brief Confronta questa stringa con un'altra stringa.
+     *
+     * @param str La stringa da confrontare.
+     * @return Un valore negativo se questa stringa è minore, zero se sono uguali, positivo se è maggiore.
+     */
+    int compare(string_view str) const noexcept;
+
+    /**
+     * @brief Confronta una porzione di questa stringa con una porzione di un'altra stringa.
+     *
+     * @param pos La posizione di inizio nella stringa corrente.
+     * @param len La lunghezza della porzione nella stringa corrente.
+     * @param str La stringa da confrontare.
+     * @return Un valore negativo se questa stringa è minore, zero se sono uguali, positivo se è maggiore.
+     *
+     * @throws std::out_of_range se la posizione è maggiore della lunghezza della stringa.
+     */
+    int compare(size_t pos, size_t len, string_view str) const noexcept;
+
+    /**
+     * @brief Estrae una linea da un flusso di input e la memorizza nella stringa.
+     *
+     * @param is Riferimento al flusso di input.
+     * @param str Riferimento alla stringa in cui memorizzare la linea.
+     * @return Riferimento al flusso di input.
+     */
+    friend std::istream& getline(std::istream& is, string& str);
+
+    /**
+     * @brief Estrae una linea da un flusso di input fino a un delimitatore specificato e la memorizza nella stringa.
+     *
+     * @param is Riferimento al flusso di input.
+     * @param str Riferimento alla stringa in cui memorizzare la linea.
+     * @param delim Il carattere delimitatore.
+     * @return Riferimento al flusso di input.
+     */
+    friend std::istream& getline(std::istream& is, string& str, char delim);
+
+    friend string& detail::append_integer(string& str, unsigned long long magnitude, bool negative);
+
+  private:
+    /** Numero massimo di caratteri (escluso il terminatore) memorizzabili nel buffer interno. */
+    static const size_t _localCapacity = 15;
+
+    char* _data;  /**< Puntatore ai dati della stringa: punta a `_local` per le stringhe corte, altrimenti allo heap. */
+    size_t _size; /**< Numero di caratteri nella stringa. */
+    union
+    {
+      size_t _capacity;                  /**< Capacità del buffer sullo heap (escluso il terminatore), valida solo se `_data` non punta a `_local`. */
+      char _local[_localCapacity + 1]; /**< Buffer interno per le stringhe corte (small-string optimization). */
+    };
+
+    /**
+     * @brief Verifica se la stringa usa il buffer interno.
+     *
+     * @return `true` se i dati risiedono in `_local`, `false` se sono sullo heap.
+     */
+    bool is_local() const;
+
+    /**
+     * @brief Alloca un buffer sullo heap per `capacity` caratteri più il terminatore.
+     *
+     * @param capacity La capacità del buffer (escluso il terminatore).
+     * @return Il buffer non inizializzato.
+     */
+    static char* allocate(size_t capacity);
+
+    /**
+     * @brief Libera un buffer ottenuto da `allocate`.
+     *
+     * @param data Il buffer da liberare.
+     * @param capacity La capacità con cui era stato allocato.
+     */
+    static void deallocate(char* data, size_t capacity) noexcept;
+
+    /**
+     * @brief Inizializza una stringa appena costruita con `n` caratteri.
+     *
+     * Le stringhe di al massimo `_localCapacity` caratteri vengono copiate nel buffer interno senza allocare.
+     *
+     * @param str Puntatore ai caratteri da copiare.
+     * @param n Il numero di caratteri da copiare.
+     */
+    void init(const char* str, size_t n);
+
+    /**
+     * @brief Rialloca il buffer interno a una nuova capacità, preservando il contenuto.
+     *
+     * @param newCapacity La nuova capacità desiderata (escluso il terminatore).
+     */
+    void reallocate(size_t newCapacity);
+
+    /**
+     * @brief Garantisce che la capacità sia almeno `minCapacity`, con crescita geometrica.
+     *
+     * La capacità viene almeno raddoppiata ad ogni riallocamento, così che una serie di
+     * aggiunte alla fine della stringa abbia un costo ammortizzato costante.
+     *
+     * @param minCapacity La capacità minima richiesta.
+     */
+    void grow(size_t minCapacity);
+
+    /**
+     * @brief Aggiunge esattamente `n` caratteri alla fine della stringa.
+     *
+     * A differenza di `append(const char*, size_t)` non si ferma al primo carattere nullo.
+     * `str` può puntare all'interno del buffer di questa stringa.
+     *
+     * @param str Puntatore ai caratteri da aggiungere.
+     * @param n Il numero di caratteri da aggiungere.
+     * @return Riferimento alla stringa modificata.
+     */
+    string& append_raw(const char* str, size_t n);
+
+    /**
+     * @brief Sostituisce `[pos, pos + len)` con esattamente `n` caratteri, in un solo passaggio.
+     *
+     * Lavora sul buffer esistente con memmove quando la capacità basta, altrimenti costruisce
+     * il risultato direttamente nel nuovo buffer. Su di essa si basano `insert` e `replace`.
+     * `str` può puntare all'interno del buffer di questa stringa.
+     *
+     * @param pos La posizione di inizio della porzione da sostituire (limitata a `size()`).
+     * @param len La lunghezza della porzione da sostituire (limitata alla fine della stringa).
+     * @param str Puntatore ai caratteri con cui sostituire.
+     * @param n Il numero di caratteri con cui sostituire.
      * @return Riferimento alla stringa modificata.
      */
-    string& operator+=(const string& other);
+    string& replace_raw(size_t pos, size_t len, const char* str, size_t n);
+
+    /**
+     * @brief Estrae caratteri da un flusso di input fino a un delimitatore, leggendo a blocchi.
+     *
+     * Salta gli spazi iniziali, poi copia l'area di lettura dello std::streambuf un blocco alla volta
+     * finché `find` non trova il delimitatore, che viene consumato ma non memorizzato.
+     * Se il flusso non è bufferizzato legge un carattere alla volta.
+     *
+     * @tparam Finder Funzione `const char*(const char* begin, const char* end)` che restituisce la posizione del delimitatore, o `end`.
+     * @param is Riferimento al flusso di input.
+     * @param str Riferimento alla stringa da riempire.
+     * @param find La funzione di ricerca del delimitatore.
+     * @return Riferimento al flusso di input.
+     */
+    template <typename Finder>
+    static std::istream& extract(std::istream& is, string& str, Finder find);
+  };
+
+  /**
+   * @brief Vista non proprietaria su una sequenza di caratteri, simile a std::string_view.
+   *
+   * Contiene solo un puntatore e una lunghezza, quindi costruirla, copiarla e ricavarne sottoviste
+   * con `substr` non alloca. I caratteri devono restare validi finché la vista viene usata e non
+   * sono necessariamente terminati da un carattere nullo. `zkl::string` si converte implicitamente
+   * in `string_view`, e tutti i suoi metodi di sola lettura accettano una vista.
+   */
+  class string_view
+  {
+  public:
+    /** Valore costante che rappresenta la posizione non valida. */
+    static const size_t npos = -1;
+
+    /**
+     * @brief Costruttore di default. Inizializza una vista vuota.
+     */
+    string_view() noexcept;
+
+    /**
+     * @brief Costruisce una vista su una stringa C.
+     *
+     * @param str Puntatore a una stringa C (null-terminated).
+     */
+    string_view(const char* str);
+
+    /**
+     * @brief Costruisce una vista sui primi `n` caratteri di un buffer.
+     *
+     * @param str Puntatore ai caratteri.
+     * @param n Il numero di caratteri.
+     */
+    string_view(const char* str, size_t n) noexcept;
+
+    /**
+     * @brief Costruisce una vista sul contenuto di una stringa.
+     *
+     * @param str La stringa da osservare. La vista non è più valida se la stringa viene modificata o distrutta.
+     */
+    string_view(const string& str) noexcept;
+
+    /**
+     * @brief Restituisce la dimensione della vista.
+     *
+     * @return Numero di caratteri nella vista.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Restituisce la lunghezza della vista.
+     *
+     * @return Numero di caratteri nella vista.
+     */
+    size_t length() const noexcept;
+
+    /**
+     * @brief Verifica se la vista è vuota.
+     *
+     * @return `true` se la vista è vuota, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti.
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento costante al carattere all'indice specificato.
+     */
+    const char& operator[](const size_t index) const;
+
+    /**
+     * @brief Accede al carattere al indice specificato con controllo dei limiti.
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento costante al carattere all'indice specificato.
+     *
+     * @throws std::out_of_range se l'indice è fuori dai limiti.
+     */
+    const char& at(const size_t index) const;
+
+    /**
+     * @brief Restituisce una referenza costante al primo carattere della vista.
+     *
+     * @return Riferimento costante al primo carattere.
+     */
+    const char& front() const;
+
+    /**
+     * @brief Restituisce una referenza costante all'ultimo carattere della vista.
+     *
+     * @return Riferimento costante all'ultimo carattere.
+     */
+    const char& back() const;
+
+    /**
+     * @brief Restituisce un puntatore ai caratteri osservati.
+     *
+     * @return Puntatore costante ai caratteri (non necessariamente null-terminated).
+     */
+    const char* data() const noexcept;
+
+    /**
+     * @brief Restringe la vista scartando i primi `n` caratteri.
+     *
+     * @param n Il numero di caratteri da scartare (al massimo `size()`).
+     */
+    void remove_prefix(size_t n);
+
+    /**
+     * @brief Restringe la vista scartando gli ultimi `n` caratteri.
+     *
+     * @param n Il numero di caratteri da scartare (al massimo `size()`).
+     */
+    void remove_suffix(size_t n);
+
+    /**
+     * @brief Scambia questa vista con un'altra.
+     *
+     * @param sv La vista con cui scambiare.
+     */
+    void swap(string_view& sv) noexcept;
+
+    /**
+     * @brief Copia una porzione della vista in un buffer.
+     *
+     * @param s Puntatore al buffer di destinazione.
+     * @param len Numero massimo di caratteri da copiare.
+     * @param pos Posizione di inizio nella vista da cui iniziare la copia.
+     * @return Numero di caratteri effettivamente copiati.
+     */
+    size_t copy(char* s, size_t len, size_t pos = 0) const;
+
+    /**
+     * @brief Restituisce una sottovista, senza copiare alcun carattere.
+     *
+     * @param pos La posizione di inizio della sottovista.
+     * @param len La lunghezza della sottovista. Se omesso, arriva fino alla fine della vista.
+     * @return La sottovista risultante.
+     *
+     * @throws std::out_of_range se `pos` è maggiore della lunghezza della vista.
+     */
+    string_view substr(size_t pos = 0, size_t len = npos) const;
+
+    /**
+     * @brief Confronta questa vista con un'altra stringa.
+     *
+     * @param str La stringa da confrontare.
+     * @return Un valore negativo se questa vista è minore, zero se sono uguali, positivo se è maggiore.
+     */
+    int compare(string_view str) const noexcept;
+
+    /**
+     * @brief Confronta una porzione di questa vista con un'altra vista.
+     *
+     * @param pos La posizione di inizio nella stringa corrente.
+     * @param len La lunghezza della porzione nella stringa corrente.
+     * @param str La stringa da confrontare.
+     * @return Un valore negativo se questa vista è minore, zero se sono uguali, positivo se è maggiore.
+     *
+     * @throws std::out_of_range se la posizione è maggiore della lunghezza della stringa.
+     */
+    int compare(size_t pos, size_t len, string_view str) const;
+
+    /**
+     * @brief Verifica se la vista inizia con un prefisso.
+     *
+     * @param sv Il prefisso da verificare.
+     * @return `true` se la vista inizia con `sv`, `false` altrimenti.
+     */
+    bool starts_with(string_view sv) const noexcept;
+
+    /**
+     * @brief Verifica se la vista termina con un suffisso.
+     *
+     * @param sv Il suffisso da verificare.
+     * @return `true` se la vista termina con `sv`, `false` altrimenti.
+     */
+    bool ends_with(string_view sv) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di una stringa all'interno di questa vista.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(string_view str, size_t pos = 0) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di un carattere all'interno di questa vista.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(char c, size_t pos = 0) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di una sottostringa all'interno di questa vista.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @param n Numero massimo di caratteri da considerare nella stringa da cercare.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find(string_view str, size_t pos, size_t n) const noexcept;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di una stringa all'interno di questa vista.
+     *
+     * @param str La stringa da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t rfind(string_view str, size_t pos = npos) const noexcept;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di un carattere all'interno di questa vista.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t rfind(char c, size_t pos = npos) const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa vista.
+     *
+     * @param str La stringa contenente i caratteri da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(string_view str, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima occorrenza di qualsiasi carattere appartenente a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(const char_set& set, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima occorrenza di un carattere specifico all'interno di questa vista.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_of(char c, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa vista.
+     *
+     * @param str La stringa contenente i caratteri da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(string_view str, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di qualsiasi carattere appartenente a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(const char_set& set, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima occorrenza di un carattere specifico all'interno di questa vista.
+     *
+     * @param c Il carattere da cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_of(char c, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca la prima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa vista.
+     *
+     * @param str La stringa contenente i caratteri da escludere.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(string_view str, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima posizione il cui carattere non appartiene a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(const char_set& set, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca la prima posizione in cui un carattere specifico non si trova all'interno di questa vista.
+     *
+     * @param c Il carattere da escludere.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_first_not_of(char c, size_t pos = 0) const;
+
+    /**
+     * @brief Cerca l'ultima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa vista.
+     *
+     * @param str La stringa contenente i caratteri da escludere.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(string_view str, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima posizione il cui carattere non appartiene a un insieme.
+     *
+     * L'insieme è già costruito, quindi la ricerca è lineare nella lunghezza della stringa.
+     *
+     * @param set L'insieme di caratteri.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(const char_set& set, size_t pos = npos) const;
+
+    /**
+     * @brief Cerca l'ultima posizione in cui un carattere specifico non si trova all'interno di questa vista.
+     *
+     * @param c Il carattere da escludere.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     */
+    size_t find_last_not_of(char c, size_t pos = npos) const;
+
+    /**
+     * @brief Divide la vista in campi separati da un carattere, senza copiare né allocare.
+     *
+     * @param delim Il carattere delimitatore.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi; la vista deve restare valida mentre lo si usa.
+     */
+    split_range<detail::char_delimiter> split(char delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+    /**
+     * @brief Divide la vista in campi separati da una sequenza di caratteri, senza copiare né allocare.
+     *
+     * @param delim La sequenza delimitatrice; deve restare valida come la vista.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi.
+     */
+    split_range<detail::string_delimiter> split(string_view delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+    /**
+     * @brief Divide la vista in campi separati da uno qualsiasi dei caratteri di un insieme.
+     *
+     * @param delim L'insieme dei delimitatori, copiato nell'intervallo.
+     * @param empty Se restituire o saltare i campi vuoti.
+     * @return Un intervallo pigro di viste sui campi.
+     */
+    split_range<detail::set_delimiter> split(const char_set& delim, empty_fields empty = empty_fields::keep) const noexcept;
+
+  private:
+    /** Lunghezza minima del testo oltre la quale `find` e `rfind` costruiscono la tabella degli spostamenti. */
+    static const size_t _shiftTableThreshold = 256;
+
+    const char* _data; /**< Puntatore al primo carattere osservato. */
+    size_t _size;      /**< Numero di caratteri osservati. */
+  };
+
+  /**
+   * @brief Operatore di inserimento in flusso di output per una vista.
+   *
+   * @param os Riferimento al flusso di output.
+   * @param sv La vista da inserire.
+   * @return Riferimento al flusso di output.
+   */
+  std::ostream& operator<<(std::ostream& os, string_view sv);
+
+  /**
+   * @brief Operatore di uguaglianza tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se le stringhe sono uguali, `false` altrimenti.
+   */
+  bool operator==(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Operatore di disuguaglianza tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se le stringhe sono diverse, `false` altrimenti.
+   */
+  bool operator!=(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Operatore di minore tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se `lhs` è minore di `rhs`, `false` altrimenti.
+   */
+  bool operator<(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Operatore di minore o uguale tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se `lhs` è minore o uguale a `rhs`, `false` altrimenti.
+   */
+  bool operator<=(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Operatore di maggiore tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se `lhs` è maggiore di `rhs`, `false` altrimenti.
+   */
+  bool operator>(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Operatore di maggiore o uguale tra due stringhe o viste.
+   *
+   * @param lhs La stringa di sinistra.
+   * @param rhs La stringa di destra.
+   * @return `true` se `lhs` è maggiore o uguale a `rhs`, `false` altrimenti.
+   */
+  bool operator>=(string_view lhs, string_view rhs) noexcept;
+
+  /**
+   * @brief Scambia il contenuto di due stringhe.
+   *
+   * @param x La prima stringa.
+   * @param y La seconda stringa.
+   */
+  void swap(string& x, string& y);
+
+  /**
+   * @brief Concatena un numero qualsiasi di pezzi con una sola allocazione.
+   *
+   * Somma prima le lunghezze di tutti i pezzi, riserva una volta sola la capacità esatta e poi
+   * copia ogni pezzo esattamente una volta. I pezzi possono essere `zkl::string`, `zkl::string_view`,
+   * stringhe C o singoli `char`, anche mescolati: `zkl::concat(key, ':', name, "/", suffix)`. Gli
+   * altri tipi numerici non compilano: vanno prima convertiti con `zkl::to_string`.
+   *
+   * @tparam First Il tipo del primo pezzo.
+   * @tparam Rest I tipi dei pezzi successivi.
+   * @param first Il primo pezzo.
+   * @param rest I pezzi successivi.
+   * @return Nuova stringa risultante dalla concatenazione.
+   */
+  template <typename First, typename... Rest>
+  string concat(const First& first, const Rest&... rest);
+
+  namespace detail
+  {
+    /** Abilita un template solo per i tipi interi (escluso `bool`) fino a 64 bit. */
+    template <typename T>
+    using enable_if_integer = typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= sizeof(unsigned long long), int>::type;
+
+    /** Abilita un template solo per i tipi in virgola mobile. */
+    template <typename T>
+    using enable_if_floating = typename std::enable_if<std::is_floating_point<T>::value, int>::type;
+  } // namespace detail
+
+  /**
+   * @brief Risultato di `from_chars`, con lo stesso significato di `std::from_chars_result`.
+   */
+  struct from_chars_result
+  {
+    const char* ptr; /**< Il primo carattere non usato dalla conversione. */
+    std::errc ec;    /**< `std::errc()` se riuscita, `invalid_argument` se non c'è un numero, `result_out_of_range` se non è rappresentabile. */
+  };
+
+  /**
+   * @brief Aggiunge un intero in base 10 alla fine di una stringa, scrivendo direttamente nel suo buffer.
+   *
+   * Non usa stream né locale e non lancia eccezioni se non per la memoria esaurita.
+   *
+   * @param str La stringa a cui aggiungere.
+   * @param value Il valore da scrivere.
+   * @return Riferimento a `str`.
+   */
+  template <typename T, detail::enable_if_integer<T> = 0>
+  string& append_number(string& str, T value);
+
+  /**
+   * @brief Aggiunge un numero in virgola mobile alla fine di una stringa, nella forma più corta che rilegge lo stesso valore.
+   *
+   * Sceglie tra notazione fissa e scientifica la più corta, come `std::to_chars` senza formato
+   * (che in libstdc++ usa Ryu); infiniti e NaN diventano `inf`, `-inf` e `nan`.
+   *
+   * @param str La stringa a cui aggiungere.
+   * @param value Il valore da scrivere.
+   * @return Riferimento a `str`.
+   */
+  template <typename T, detail::enable_if_floating<T> = 0>
+  string& append_number(string& str, T value);
+
+  /**
+   * @brief Converte un numero in stringa con `append_number`; i risultati fino a 15 caratteri non allocano.
+   *
+   * @param value Il valore da convertire, intero o in virgola mobile.
+   * @return La stringa risultante.
+   */
+  template <typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+  string to_string(T value);
+
+  /**
+   * @brief Legge un intero da `[first, last)`, senza spazi iniziali né segno '+', come `std::from_chars`.
+   *
+   * @param first Inizio del testo.
+   * @param last Fine del testo.
+   * @param[out] value Il valore letto; non viene modificato in caso di errore.
+   * @param base La base, da 2 a 36; le cifre oltre il 9 sono lettere senza distinzione di maiuscole.
+   * @return Dove si è fermata la lettura e l'eventuale errore.
+   */
+  template <typename T, detail::enable_if_integer<T> = 0>
+  from_chars_result from_chars(const char* first, const char* last, T& value, int base = 10) noexcept;
+
+  /**
+   * @brief Legge un numero in virgola mobile da `[first, last)` in notazione fissa o scientifica.
+   *
+   * Indipendente dal locale: il separatore decimale è sempre '.'. Il valore letto è quello
+   * correttamente arrotondato, quindi `from_chars` rilegge esattamente l'output di `append_number`.
+   *
+   * @param first Inizio del testo.
+   * @param last Fine del testo.
+   * @param[out] value Il valore letto; non viene modificato in caso di errore.
+   * @return Dove si è fermata la lettura e l'eventuale errore.
+   */
+  template <typename T, detail::enable_if_floating<T> = 0>
+  from_chars_result from_chars(const char* first, const char* last, T& value);
+
+  /**
+   * @brief Legge un intero da una vista; come `from_chars(first, last, value, base)`.
+   */
+  template <typename T, detail::enable_if_integer<T> = 0>
+  from_chars_result from_chars(string_view text, T& value, int base = 10) noexcept;
+
+  /**
+   * @brief Legge un numero in virgola mobile da una vista; come `from_chars(first, last, value)`.
+   */
+  template <typename T, detail::enable_if_floating<T> = 0>
+  from_chars_result from_chars(string_view text, T& value);
+
+  /**
+   * @brief Insieme di caratteri riutilizzabile per le ricerche `find_*_of`.
+   *
+   * Mantiene una bitmap di 256 bit e, quando i caratteri dell'insieme hanno al massimo 8 nibble alti
+   * distinti (ad esempio qualsiasi insieme ASCII), due tabelle di 16 byte che permettono di classificare
+   * 16 o 32 caratteri alla volta con `pshufb`. Costruirlo una volta sola evita di ricostruire le tabelle
+   * ad ogni chiamata, ad esempio nei cicli di tokenizzazione.
+   */
+  class char_set
+  {
+  public:
+    /**
+     * @brief Costruttore di default. Inizializza un insieme vuoto.
+     */
+    char_set();
+
+    /**
+     * @brief Costruisce l'insieme dei primi `n` caratteri di un buffer.
+     *
+     * @param chars Puntatore ai caratteri.
+     * @param n Il numero di caratteri.
+     */
+    char_set(const char* chars, size_t n);
+
+    /**
+     * @brief Costruisce l'insieme dei caratteri di una stringa o vista.
+     *
+     * @param chars I caratteri dell'insieme.
+     */
+    explicit char_set(string_view chars);
+
+    /**
+     * @brief Aggiunge un carattere all'insieme.
+     *
+     * @param c Il carattere da aggiungere.
+     */
+    void insert(char c);
+
+    /**
+     * @brief Verifica se un carattere appartiene all'insieme.
+     *
+     * @param c Il carattere da verificare.
+     * @return `true` se il carattere appartiene all'insieme, `false` altrimenti.
+     */
+    bool contains(char c) const noexcept;
+
+  private:
+    friend class string_view;
+
+    uint64_t _bits[4];     /**< Bitmap dei 256 caratteri possibili. */
+    unsigned char _lo[16]; /**< Per ogni nibble basso, i bit dei nibble alti presenti nell'insieme. */
+    unsigned char _hi[16]; /**< Per ogni nibble alto, il bit che gli è stato assegnato (0 se assente). */
+    unsigned _hiCount;     /**< Numero di nibble alti a cui è stato assegnato un bit. */
+    bool _classifiable;    /**< `true` se le tabelle `_lo`/`_hi` descrivono esattamente l'insieme. */
+
+    /**
+     * @brief Cerca in `data[0, n)` il primo carattere dentro (`negate == false`) o fuori dall'insieme.
+     *
+     * @return L'indice trovato, o `detail::not_found`.
+     */
+    size_t scan(const char* data, size_t n, bool negate) const noexcept;
+
+    /**
+     * @brief Cerca in `data[0, n)` l'ultimo carattere dentro (`negate == false`) o fuori dall'insieme.
+     *
+     * @return L'indice trovato, o `detail::not_found`.
+     */
+    size_t rscan(const char* data, size_t n, bool negate) const noexcept;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief Delimitatore di `split` formato da un solo carattere, cercato con i kernel SIMD.
+     */
+    struct char_delimiter
+    {
+      char c; /**< Il carattere delimitatore. */
+
+      /**
+       * @brief Cerca il primo delimitatore in `data[0, n)`.
+       *
+       * @return L'indice trovato, o `not_found`.
+       */
+      size_t find(const char* data, size_t n) const noexcept;
+
+      /**
+       * @brief Restituisce la lunghezza del delimitatore.
+       */
+      size_t size() const noexcept;
+    };
+
+    /**
+     * @brief Delimitatore di `split` formato da una sequenza di caratteri.
+     *
+     * Senza tabella di Horspool: i campi sono di solito corti, quindi basta il prefiltro SIMD sul
+     * primo carattere. Una sequenza vuota non delimita nulla.
+     */
+    struct string_delimiter
+    {
+      string_view pattern; /**< La sequenza delimitatrice. */
+
+      size_t find(const char* data, size_t n) const noexcept;
+      size_t size() const noexcept;
+    };
+
+    /**
+     * @brief Delimitatore di `split` formato da uno qualsiasi dei caratteri di un insieme.
+     */
+    struct set_delimiter
+    {
+      char_set set; /**< L'insieme dei delimitatori. */
+
+      size_t find(const char* data, size_t n) const noexcept;
+      size_t size() const noexcept;
+    };
+  } // namespace detail
+
+  /**
+   * @brief Intervallo pigro dei campi di un testo, restituito da `split`.
+   *
+   * Ogni campo viene cercato solo quando l'iteratore avanza, e ogni campo è una vista sul testo
+   * originale: nessuna copia e nessuna allocazione. Con `empty_fields::keep` un testo di `n`
+   * delimitatori produce sempre `n + 1` campi (quindi un testo vuoto produce un campo vuoto);
+   * con `empty_fields::skip` i campi vuoti non compaiono.
+   *
+   * @tparam Delimiter Uno dei delimitatori di `detail`: deve fornire `find(data, n)` e `size()`.
+   */
+  template <typename Delimiter>
+  class split_range
+  {
+  public:
+    /**
+     * @brief Iteratore in avanti sui campi.
+     */
+    class iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef string_view value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const string_view* pointer;
+      typedef const string_view& reference;
+
+      /**
+       * @brief Costruisce l'iteratore di fine.
+       */
+      iterator() noexcept;
+
+      const string_view& operator*() const noexcept;
+      const string_view* operator->() const noexcept;
+      iterator& operator++() noexcept;
+      iterator operator++(int) noexcept;
+
+      bool operator==(const iterator& other) const noexcept;
+      bool operator!=(const iterator& other) const noexcept;
+
+    private:
+      friend class split_range;
+
+      const split_range* _range; /**< L'intervallo percorso, `nullptr` alla fine. */
+      string_view _field;        /**< Campo corrente. */
+      const char* _next;         /**< Inizio del campo successivo. */
+      bool _last;                /**< `true` se il campo corrente è l'ultimo del testo. */
+
+      /**
+       * @brief Costruisce un iteratore sul primo campo di `range`.
+       */
+      explicit iterator(const split_range* range) noexcept;
+
+      /**
+       * @brief Passa al campo successivo da restituire, o alla fine.
+       */
+      void advance() noexcept;
+    };
+
+    /**
+     * @brief Costruisce l'intervallo dei campi di un testo.
+     *
+     * @param text Il testo da dividere.
+     * @param delimiter Il delimitatore.
+     * @param empty Se restituire o saltare i campi vuoti.
+     */
+    split_range(string_view text, const Delimiter& delimiter, empty_fields empty) noexcept;
+
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+  private:
+    string_view _text;    /**< Il testo diviso. */
+    Delimiter _delimiter; /**< Il delimitatore. */
+    empty_fields _empty;  /**< Se restituire i campi vuoti. */
+  };
+
+  /**
+   * @brief Divide un testo in campi separati da un carattere, senza copiare né allocare.
+   *
+   * Il testo deve restare valido mentre si usa l'intervallo: attenzione alle stringhe temporanee.
+   *
+   * @param text Il testo da dividere (una `zkl::string` si converte implicitamente).
+   * @param delim Il carattere delimitatore.
+   * @param empty Se restituire o saltare i campi vuoti.
+   * @return Un intervallo pigro di viste sui campi.
+   */
+  split_range<detail::char_delimiter> split(string_view text, char delim, empty_fields empty = empty_fields::keep) noexcept;
+
+  /**
+   * @brief Divide un testo in campi separati da una sequenza di caratteri, senza copiare né allocare.
+   *
+   * @param text Il testo da dividere.
+   * @param delim La sequenza delimitatrice; deve restare valida come il testo.
+   * @param empty Se restituire o saltare i campi vuoti.
+   * @return Un intervallo pigro di viste sui campi.
+   */
+  split_range<detail::string_delimiter> split(string_view text, string_view delim, empty_fields empty = empty_fields::keep) noexcept;
+
+  /**
+   * @brief Divide un testo in campi separati da uno qualsiasi dei caratteri di un insieme.
+   *
+   * @param text Il testo da dividere.
+   * @param delim L'insieme dei delimitatori, copiato nell'intervallo.
+   * @param empty Se restituire o saltare i campi vuoti.
+   * @return Un intervallo pigro di viste sui campi.
+   */
+  split_range<detail::set_delimiter> split(string_view text, const char_set& delim, empty_fields empty = empty_fields::keep) noexcept;
+
+  /**
+   * @brief Ricerca riutilizzabile di un pattern fisso (Boyer–Moore–Horspool con prefiltro SIMD).
+   *
+   * Le tabelle degli spostamenti vengono costruite una sola volta nel costruttore, così che
+   * cercare lo stesso pattern in molti testi non le ricostruisca ad ogni chiamata.
+   * I caratteri nulli all'interno del pattern sono supportati.
+   */
+  class searcher
+  {
+  public:
+    /**
+     * @brief Costruisce un searcher per il pattern specificato.
+     *
+     * @param pattern La stringa da cercare.
+     */
+    searcher(string_view pattern);
+
+    /**
+     * @brief Restituisce il pattern cercato.
+     *
+     * @return Riferimento costante al pattern.
+     */
+    const string& pattern() const noexcept;
+
+    /**
+     * @brief Cerca la prima occorrenza del pattern in un testo.
+     *
+     * @param text Il testo in cui cercare.
+     * @param pos La posizione di inizio della ricerca.
+     * @return La posizione della prima occorrenza trovata, o `string::npos` se non trovata.
+     */
+    size_t find(string_view text, size_t pos = 0) const noexcept;
+
+    /**
+     * @brief Cerca l'ultima occorrenza del pattern in un testo.
+     *
+     * @param text Il testo in cui cercare.
+     * @param pos La posizione massima da cui iniziare la ricerca.
+     * @return La posizione dell'ultima occorrenza trovata, o `string::npos` se non trovata.
+     */
+    size_t rfind(string_view text, size_t pos = string::npos) const noexcept;
+
+  private:
+    string _pattern;     /**< Copia del pattern cercato. */
+    size_t _shift[256];  /**< Spostamenti di Horspool per la ricerca in avanti, indicizzati per carattere. */
+    size_t _rshift[256]; /**< Spostamenti per la ricerca all'indietro, indicizzati per carattere. */
+  };
+
+  /**
+   * @brief File in sola lettura mappato in memoria, con iterazione per righe senza copie.
+   *
+   * Il file viene mappato con `mmap` e segnalato al kernel con `madvise(MADV_SEQUENTIAL)`, che
+   * legge in anticipo e può scartare le pagine già lette: i byte arrivano direttamente dalla page
+   * cache, senza passare da iostream, e anche i file più grandi della RAM si leggono per intero.
+   * `lines()` restituisce viste su record delimitati, trovati con gli stessi kernel SIMD di `find`;
+   * le viste restano valide finché il file resta mappato. Solo sistemi POSIX.
+   */
+  class mapped_file
+  {
+  public:
+    /**
+     * @brief Iteratore in avanti sui record del file; ogni record è una vista senza delimitatore.
+     *
+     * Come `getline`, un delimitatore finale non produce un record vuoto in più.
+     */
+    class line_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef string_view value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const string_view* pointer;
+      typedef const string_view& reference;
+
+      /**
+       * @brief Costruisce l'iteratore di fine.
+       */
+      line_iterator() noexcept;
+
+      /**
+       * @brief Costruisce un iteratore sul primo record di `[begin, end)`.
+       *
+       * @param begin Inizio dei dati.
+       * @param end Fine dei dati.
+       * @param delim Il carattere delimitatore.
+       */
+      line_iterator(const char* begin, const char* end, char delim) noexcept;
+
+      const string_view& operator*() const noexcept;
+      const string_view* operator->() const noexcept;
+      line_iterator& operator++() noexcept;
+      line_iterator operator++(int) noexcept;
+
+      bool operator==(const line_iterator& other) const noexcept;
+      bool operator!=(const line_iterator& other) const noexcept;
+
+    private:
+      string_view _line; /**< Record corrente. */
+      const char* _next; /**< Inizio del record successivo, o `nullptr` alla fine. */
+      const char* _end;  /**< Fine dei dati. */
+      char _delim;       /**< Il carattere delimitatore. */
+
+      /**
+       * @brief Trova il record che inizia in `_next`, o passa alla fine se non ce ne sono altri.
+       */
+      void advance() noexcept;
+    };
+
+    /**
+     * @brief Intervallo dei record di un file, per i cicli range-for.
+     */
+    class line_range
+    {
+    public:
+      line_range(const char* begin, const char* end, char delim) noexcept;
+
+      line_iterator begin() const noexcept;
+      line_iterator end() const noexcept;
+
+    private:
+      const char* _begin; /**< Inizio dei dati. */
+      const char* _end;   /**< Fine dei dati. */
+      char _delim;        /**< Il carattere delimitatore. */
+    };
+
+    /**
+     * @brief Costruisce un oggetto senza file.
+     */
+    mapped_file() noexcept;
+
+    /**
+     * @brief Apre e mappa un file.
+     *
+     * @param path Il percorso del file.
+     * @throws std::system_error se il file non può essere aperto o mappato.
+     */
+    explicit mapped_file(const char* path);
+
+    /**
+     * @brief Apre e mappa un file.
+     *
+     * @param path Il percorso del file.
+     * @throws std::system_error se il file non può essere aperto o mappato.
+     */
+    explicit mapped_file(const string& path);
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    /**
+     * @brief Costruttore di spostamento. La mappatura passa al nuovo oggetto.
+     */
+    mapped_file(mapped_file&& other) noexcept;
+
+    /**
+     * @brief Assegnazione per spostamento. Chiude il file corrente e prende la mappatura di `other`.
+     */
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    /**
+     * @brief Distruttore. Rimuove la mappatura.
+     */
+    ~mapped_file();
+
+    /**
+     * @brief Rimuove la mappatura; le viste ottenute prima non sono più valide.
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Verifica se un file è mappato (anche se vuoto).
+     */
+    bool is_open() const noexcept;
+
+    /**
+     * @brief Restituisce il contenuto del file.
+     *
+     * @return Puntatore ai byte del file, `nullptr` se il file è vuoto o non aperto.
+     */
+    const char* data() const noexcept;
+
+    /**
+     * @brief Restituisce la dimensione del file in byte.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Verifica se il file è vuoto.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Restituisce una vista sull'intero file.
+     */
+    string_view view() const noexcept;
+
+    /**
+     * @brief Restituisce i record del file separati da `delim`.
+     *
+     * @param delim Il carattere delimitatore (default: a capo).
+     * @return Un intervallo di viste, da usare con range-for.
+     */
+    line_range lines(char delim = '\n') const noexcept;
+
+  private:
+    const char* _data; /**< Inizio della mappatura, `nullptr` se il file è vuoto o non aperto. */
+    size_t _size;      /**< Dimensione del file. */
+    bool _open;        /**< Indica se un file è stato aperto. */
+
+    /**
+     * @brief Apre e mappa `path`; usato dai costruttori.
+     */
+    void open(const char* path);
+  };
+
+  /**
+   * @brief Stringa immutabile con buffer condiviso tramite un contatore di riferimenti atomico.
+   *
+   * Copiare una `shared_string` incrementa solo il contatore: nessuna allocazione e nessuna copia
+   * dei caratteri, anche tra thread diversi. Il buffer viene liberato quando l'ultima copia viene
+   * distrutta. Poiché il contenuto non può essere modificato, più thread possono leggerlo
+   * contemporaneamente senza sincronizzazione.
+   */
+  class shared_string
+  {
+  public:
+    /**
+     * @brief Costruttore di default. Inizializza una stringa vuota senza allocare.
+     */
+    shared_string() noexcept;
+
+    /**
+     * @brief Costruisce una stringa condivisa copiando una stringa C.
+     *
+     * @param str Puntatore a una stringa C (null-terminated).
+     */
+    shared_string(const char* str);
+
+    /**
+     * @brief Costruisce una stringa condivisa copiando il contenuto di una stringa o vista.
+     *
+     * @param sv I caratteri da copiare.
+     */
+    explicit shared_string(string_view sv);
+
+    /**
+     * @brief Costruisce una stringa condivisa copiando il contenuto di una `zkl::string`.
+     *
+     * @param str La stringa da copiare.
+     */
+    shared_string(const string& str);
+
+    /**
+     * @brief Costruttore di copia. Condivide il buffer incrementando il contatore dei riferimenti.
+     *
+     * @param other La stringa condivisa da copiare.
+     */
+    shared_string(const shared_string& other) noexcept;
+
+    /**
+     * @brief Costruttore di spostamento. Trasferisce il riferimento senza toccare il contatore.
+     *
+     * @param other La stringa condivisa da spostare, che rimane vuota.
+     */
+    shared_string(shared_string&& other) noexcept;
+
+    /**
+     * @brief Distruttore. Rilascia il riferimento e libera il buffer se era l'ultimo.
+     */
+    ~shared_string();
+
+    /**
+     * @brief Operatore di assegnazione di copia. Condivide il buffer di un'altra stringa condivisa.
+     *
+     * @param other La stringa condivisa da assegnare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    shared_string& operator=(const shared_string& other) noexcept;
+
+    /**
+     * @brief Operatore di assegnazione di spostamento.
+     *
+     * @param other La stringa condivisa da spostare, che rimane vuota.
+     * @return Riferimento alla stringa assegnata.
+     */
+    shared_string& operator=(shared_string&& other) noexcept;
+
+    /**
+     * @brief Restituisce la dimensione della stringa.
+     *
+     * @return Numero di caratteri nella stringa.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Restituisce la lunghezza della stringa.
+     *
+     * @return Numero di caratteri nella stringa.
+     */
+    size_t length() const noexcept;
+
+    /**
+     * @brief Verifica se la stringa è vuota.
+     *
+     * @return `true` se la stringa è vuota, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Operatore di indicizzazione per l'accesso ai caratteri senza controllo dei limiti.
+     *
+     * @param index L'indice del carattere da accedere.
+     * @return Riferimento costante al carattere all'indice specificato.
+     */
+    const char& operator[](const size_t index) const;
+
+    /**
+     * @brief Restituisce un puntatore alla stringa C condivisa.
+     *
+     * @return Puntatore costante alla stringa C (mai nullo).
+     */
+    const char* c_str() const noexcept;
+
+    /**
+     * @brief Restituisce un puntatore ai dati condivisi.
+     *
+     * @return Puntatore costante ai dati della stringa.
+     */
+    const char* data() const noexcept;
 
     /**
-     * @brief Aggiunge una stringa C alla fine di questa stringa.
+     * @brief Restituisce il numero di `shared_string` che condividono lo stesso buffer.
      *
-     * @param str La stringa C da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @return Il numero di riferimenti, o 0 per una stringa vuota senza buffer.
      */
-    string& operator+=(const char* str);
+    size_t use_count() const noexcept;
 
     /**
-     * @brief Aggiunge un carattere alla fine di questa stringa.
+     * @brief Crea una `zkl::string` modificabile con lo stesso contenuto.
      *
-     * @param c Il carattere da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @return Una copia del contenuto.
      */
-    string& operator+=(char c);
+    string str() const;
 
     /**
-     * @brief Concatenazione di due stringhe.
+     * @brief Conversione implicita in vista, per usare le ricerche e i confronti di `string_view`.
      *
-     * @param left La stringa di sinistra.
-     * @param right La stringa di destra.
-     * @return Nuova stringa risultante dalla concatenazione.
+     * @return Una vista sul buffer condiviso.
      */
-    friend string operator+(const string& left, const string& right);
+    operator string_view() const noexcept;
+
+  private:
+    struct block;
+
+    block* _block; /**< Blocco condiviso con contatore e caratteri, o `nullptr` per la stringa vuota. */
 
     /**
-     * @brief Concatenazione di un carattere e una stringa.
+     * @brief Alloca un nuovo blocco con il contatore a 1 e una copia dei caratteri.
      *
-     * @param left Il carattere di sinistra.
-     * @param right La stringa di destra.
-     * @return Nuova stringa risultante dalla concatenazione.
+     * @param str Puntatore ai caratteri da copiare.
+     * @param n Il numero di caratteri.
+     * @return Il blocco allocato, o `nullptr` se `n` è 0.
      */
-    friend string operator+(char left, const string& right);
+    static block* make_block(const char* str, size_t n);
 
     /**
-     * @brief Concatenazione di una stringa e un carattere.
+     * @brief Rilascia il riferimento corrente, liberando il blocco se era l'ultimo.
+     */
+    void release() noexcept;
+  };
+
+  /**
+   * @brief Calcola un hash non crittografico a 64 bit di una sequenza di byte.
+   *
+   * Gli input fino a 256 byte usano una funzione della famiglia wyhash (moltiplicazioni 64×64→128);
+   * quelli più lunghi accumulano blocchi di 64 byte in 8 corsie indipendenti, con kernel SSE2/AVX2
+   * selezionati a runtime. Il risultato non dipende dal kernel usato, ma non è stabile tra versioni
+   * della libreria: non va salvato su disco né usato per protezione da input ostili.
+   *
+   * @param data Puntatore ai byte.
+   * @param n Numero di byte.
+   * @param seed Seme opzionale che modifica il risultato.
+   * @return L'hash dei byte.
+   */
+  uint64_t hash_bytes(const void* data, size_t n, uint64_t seed = 0) noexcept;
+
+  /**
+   * @brief Funtore di hash per stringhe, usato anche dalle specializzazioni di `std::hash`.
+   *
+   * Accetta qualsiasi tipo convertibile in `string_view` (`string`, `shared_string`, stringhe C) e
+   * produce lo stesso valore per lo stesso contenuto; `is_transparent` abilita la ricerca eterogenea
+   * nei contenitori che la supportano. Per `hashed_string` restituisce l'hash memorizzato.
+   */
+  struct hash
+  {
+    using is_transparent = void;
+
+    /**
+     * @brief Calcola l'hash del contenuto di una stringa.
      *
-     * @param left La stringa di sinistra.
-     * @param right Il carattere di destra.
-     * @return Nuova stringa risultante dalla concatenazione.
+     * @param str La stringa.
+     * @return L'hash della stringa.
      */
-    friend string operator+(const string& left, char right);
+    size_t operator()(string_view str) const noexcept;
 
     /**
-     * @brief Aggiunge una stringa alla fine di questa stringa.
+     * @brief Restituisce l'hash di una `hashed_string`, calcolandolo solo la prima volta.
      *
-     * @param str La stringa da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param str La stringa.
+     * @return L'hash della stringa, uguale a quello del suo contenuto.
      */
-    string& append(const string& str);
+    size_t operator()(const hashed_string& str) const noexcept;
+  };
 
+  /**
+   * @brief Stringa immutabile che memorizza il proprio hash dopo il primo calcolo.
+   *
+   * Pensata per le chiavi cercate molte volte: l'hash viene calcolato al primo utilizzo e poi
+   * restituito senza rileggere i caratteri, e il confronto tra due `hashed_string` scarta subito
+   * quelle con hash diversi. Occupa una parola in più di `zkl::string`. Il calcolo pigro è sicuro
+   * anche se più thread leggono la stessa stringa.
+   */
+  class hashed_string
+  {
+  public:
     /**
-     * @brief Aggiunge una sottostringa di un'altra stringa alla fine di questa stringa.
+     * @brief Costruttore di default. Inizializza una stringa vuota.
+     */
+    hashed_string() noexcept;
+
+    /**
+     * @brief Costruisce una stringa copiando il contenuto di una stringa o vista.
      *
-     * @param str La stringa da cui prendere la sottostringa.
-     * @param subpos La posizione di inizio nella stringa `str`.
-     * @param sublen La lunghezza della sottostringa da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param str I caratteri da copiare.
      */
-    string& append(const string& str, size_t subpos, size_t sublen);
+    explicit hashed_string(string_view str);
 
     /**
-     * @brief Aggiunge una stringa C alla fine di questa stringa.
+     * @brief Costruisce una stringa prendendo possesso del buffer di una `zkl::string`.
      *
-     * @param str La stringa C da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param str La stringa da spostare.
      */
-    string& append(const char* str);
+    explicit hashed_string(string&& str) noexcept;
 
     /**
-     * @brief Aggiunge i primi `n` caratteri di una stringa C alla fine di questa stringa.
+     * @brief Costruttore di copia. Copia anche l'hash, se già calcolato.
      *
-     * @param str La stringa C da aggiungere.
-     * @param n Il numero massimo di caratteri da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param other La stringa da copiare.
      */
-    string& append(const char* str, size_t n);
+    hashed_string(const hashed_string& other);
 
     /**
-     * @brief Aggiunge `n` copie di un carattere alla fine di questa stringa.
+     * @brief Costruttore di spostamento. Trasferisce il buffer e l'hash.
      *
-     * @param n Il numero di copie del carattere da aggiungere.
-     * @param c Il carattere da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param other La stringa da spostare.
      */
-    string& append(size_t n, char c);
+    hashed_string(hashed_string&& other) noexcept;
 
     /**
-     * @brief Aggiunge un carattere alla fine della stringa.
+     * @brief Operatore di assegnazione di copia.
      *
-     * @param c Il carattere da aggiungere.
-     * @return Riferimento alla stringa modificata.
+     * @param other La stringa da copiare.
+     * @return Riferimento alla stringa assegnata.
      */
-    string& push_back(char c);
+    hashed_string& operator=(const hashed_string& other);
+
+    /**
+     * @brief Operatore di assegnazione di spostamento.
+     *
+     * @param other La stringa da spostare.
+     * @return Riferimento alla stringa assegnata.
+     */
+    hashed_string& operator=(hashed_string&& other) noexcept;
+
+    /**
+     * @brief Sostituisce il contenuto e scarta l'hash memorizzato.
+     *
+     * @param str I nuovi caratteri.
+     * @return Riferimento alla stringa assegnata.
+     */
+    hashed_string& operator=(string_view str);
+
+    /**
+     * @brief Restituisce l'hash del contenuto, calcolandolo solo alla prima chiamata.
+     *
+     * @return Lo stesso valore di `zkl::hash{}(string_view(*this))`.
+     */
+    size_t hash() const noexcept;
+
+    /**
+     * @brief Restituisce la dimensione della stringa.
+     *
+     * @return Numero di caratteri nella stringa.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Verifica se la stringa è vuota.
+     *
+     * @return `true` se la stringa è vuota, `false` altrimenti.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Restituisce un puntatore alla stringa C.
+     *
+     * @return Puntatore costante alla stringa C.
+     */
+    const char* c_str() const noexcept;
+
+    /**
+     * @brief Restituisce la stringa sottostante.
+     *
+     * @return Riferimento costante alla `zkl::string` contenuta.
+     */
+    const string& str() const noexcept;
+
+    /**
+     * @brief Conversione implicita in vista, per usare le ricerche e i confronti di `string_view`.
+     *
+     * @return Una vista sul contenuto.
+     */
+    operator string_view() const noexcept;
+
+    friend bool operator==(const hashed_string& lhs, const hashed_string& rhs) noexcept;
+    friend bool operator!=(const hashed_string& lhs, const hashed_string& rhs) noexcept;
+
+  private:
+    string _str;                       /**< Il contenuto. */
+    mutable std::atomic<size_t> _hash; /**< Hash memorizzato, o 0 se non ancora calcolato. */
+  };
+
+  /**
+   * @brief Tabella thread-safe per l'interning delle stringhe.
+   *
+   * Ogni stringa distinta viene memorizzata una sola volta, in blocchi contigui (arena), e identificata
+   * da un `handle` di 32 bit. Confrontare o calcolare l'hash di due handle costa quanto confrontare due
+   * interi, invece di confrontare le stringhe carattere per carattere. Le stringhe restano valide e
+   * ferme in memoria finché la tabella esiste.
+   *
+   * `intern` può essere chiamato da più thread contemporaneamente; la ricerca di stringhe già presenti
+   * usa un lock condiviso, l'inserimento un lock esclusivo. `view` non prende alcun lock.
+   */
+  class intern_table
+  {
+  public:
+    /**
+     * @brief Identificatore compatto di una stringa internata.
+     *
+     * Due handle della stessa tabella sono uguali se e solo se le stringhe sono uguali.
+     */
+    class handle
+    {
+    public:
+      /**
+       * @brief Costruttore di default. Crea un handle non valido.
+       */
+      handle() noexcept;
+
+      /**
+       * @brief Verifica se l'handle si riferisce a una stringa.
+       *
+       * @return `true` se l'handle è valido, `false` altrimenti.
+       */
+      bool valid() const noexcept;
+
+      /**
+       * @brief Restituisce l'identificatore numerico dell'handle.
+       *
+       * @return L'identificatore (0 per un handle non valido).
+       */
+      uint32_t id() const noexcept;
+
+      /**
+       * @brief Restituisce l'hash dell'handle, cioè il suo identificatore.
+       *
+       * @return L'hash dell'handle.
+       */
+      size_t hash() const noexcept;
+
+      friend bool operator==(handle lhs, handle rhs) noexcept;
+      friend bool operator!=(handle lhs, handle rhs) noexcept;
+      friend bool operator<(handle lhs, handle rhs) noexcept;
+
+    private:
+      friend class intern_table;
+
+      explicit handle(uint32_t id) noexcept;
+
+      uint32_t _id; /**< Indice della stringa nella tabella + 1, 0 se non valido. */
+    };
+
+    /**
+     * @brief Costruttore di default. Crea una tabella vuota.
+     */
+    intern_table();
+
+    intern_table(const intern_table&) = delete;
+    intern_table& operator=(const intern_table&) = delete;
+
+    /**
+     * @brief Distruttore. Libera l'arena e tutte le stringhe internate.
+     */
+    ~intern_table();
+
+    /**
+     * @brief Restituisce l'handle di una stringa, inserendola se non è ancora presente.
+     *
+     * @param str La stringa da internare.
+     * @return L'handle della stringa.
+     */
+    handle intern(string_view str);
+
+    /**
+     * @brief Cerca una stringa senza inserirla.
+     *
+     * @param str La stringa da cercare.
+     * @return L'handle della stringa, o un handle non valido se non è presente.
+     */
+    handle lookup(string_view str) const;
+
+    /**
+     * @brief Restituisce la stringa associata a un handle.
+     *
+     * @param h Un handle valido ottenuto da questa tabella.
+     * @return Una vista sulla stringa internata, terminata da un carattere nullo.
+     */
+    string_view view(handle h) const noexcept;
+
+    /**
+     * @brief Restituisce il numero di stringhe distinte internate.
+     *
+     * @return Numero di stringhe nella tabella.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Restituisce i byte occupati dalle stringhe nell'arena.
+     *
+     * @return Byte allocati per i blocchi dell'arena.
+     */
+    size_t arena_bytes() const;
+
+  private:
+    struct chunk;
+
+    /** Posizione e lunghezza di una stringa internata nell'arena. */
+    struct entry
+    {
+      const char* data;
+      size_t size;
+    };
+
+    /** Cella della tabella hash: indice della stringa + 1 (0 se vuota) e hash a 32 bit. */
+    struct slot
+    {
+      uint32_t id;
+      uint32_t hash;
+    };
+
+    /** Dimensione dei blocchi dell'arena; le stringhe più lunghe ricevono un blocco dedicato. */
+    static const size_t _chunkSize = 64 * 1024;
+
+    /** Numero di elementi del primo segmento di `_entries`; ogni segmento successivo raddoppia. */
+    static const size_t _firstSegment = 64;
+
+    /** Numero massimo di segmenti di `_entries`. */
+    static const size_t _segmentCount = 26;
+
+    entry* _entries[_segmentCount];   /**< Segmenti che non vengono mai spostati, così `view` non ha bisogno di lock. */
+    size_t _size;                     /**< Numero di stringhe internate. */
+    slot* _slots;                     /**< Tabella hash ad indirizzamento aperto (sondaggio lineare). */
+    size_t _slotCount;                /**< Numero di celle di `_slots`, sempre una potenza di 2. */
+    chunk* _chunks;                   /**< Lista dei blocchi dell'arena, il più recente in testa. */
+    size_t _arenaBytes;               /**< Byte allocati per i blocchi dell'arena. */
+    mutable std::shared_mutex _mutex; /**< Protegge `_slots`, `_size` e l'arena. */
+
+    /**
+     * @brief Calcola l'hash a 32 bit usato dalla tabella.
+     */
+    static uint32_t hash_of(string_view str) noexcept;
+
+    /**
+     * @brief Restituisce l'elemento di `_entries` con l'indice specificato.
+     */
+    entry& entry_at(size_t index) const noexcept;
+
+    /**
+     * @brief Cerca una stringa nella tabella hash. Richiede almeno il lock condiviso.
+     *
+     * @return L'indice della stringa + 1, o 0 se non presente.
+     */
+    uint32_t find_id(string_view str, uint32_t hash) const noexcept;
+
+    /**
+     * @brief Copia una stringa (con terminatore) nell'arena. Richiede il lock esclusivo.
+     *
+     * @return Puntatore alla copia nell'arena.
+     */
+    const char* store(string_view str);
+
+    /**
+     * @brief Ridimensiona la tabella hash. Richiede il lock esclusivo.
+     *
+     * @param newSlotCount Il nuovo numero di celle (potenza di 2).
+     */
+    void rehash(size_t newSlotCount);
+  };
+
+  namespace detail
+  {
+    /** Funtore di hash di default di `flat_hash_map`: `std::hash`, o `zkl::hash` per le stringhe. */
+    template <typename K>
+    struct default_hash
+    {
+      typedef std::hash<K> type;
+    };
+
+    template <>
+    struct default_hash<string>
+    {
+      typedef zkl::hash type;
+    };
+
+    template <>
+    struct default_hash<string_view>
+    {
+      typedef zkl::hash type;
+    };
+
+    template <>
+    struct default_hash<shared_string>
+    {
+      typedef zkl::hash type;
+    };
+
+    template <>
+    struct default_hash<hashed_string>
+    {
+      typedef zkl::hash type;
+    };
+
+    /** Confronto di default di `flat_hash_map`: trasparente per le stringhe, per la ricerca con `const char*`. */
+    template <typename K>
+    struct default_equal
+    {
+      typedef typename std::conditional<std::is_same<typename default_hash<K>::type, zkl::hash>::value, std::equal_to<>, std::equal_to<K>>::type type;
+    };
+
+    /** Indica se un funtore di hash distribuisce già bene tutti i bit, così la tabella non lo rimescola. */
+    template <typename Hash>
+    struct hash_is_avalanching : std::false_type
+    {
+    };
+
+    template <>
+    struct hash_is_avalanching<zkl::hash> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Abilita gli overload di ricerca eterogenea per `Q` quando hash e confronto sono entrambi trasparenti.
+     *
+     * Dipende da `Q` perché l'errore di sostituzione avvenga durante la deduzione e non all'istanziazione della classe.
+     */
+    template <typename Hash, typename KeyEqual, typename Q, typename = void>
+    struct transparent_key
+    {
+    };
+
+    template <typename Hash, typename KeyEqual, typename Q>
+    struct transparent_key<Hash, KeyEqual, Q, std::void_t<typename Hash::is_transparent, typename KeyEqual::is_transparent>>
+    {
+      typedef void type;
+    };
+  } // namespace detail
+
+  /**
+   * @brief Tabella hash ad indirizzamento aperto, simile a std::unordered_map.
+   *
+   * Gli elementi sono memorizzati in un unico array contiguo di celle (nessun nodo per elemento).
+   * Accanto alle celle c'è un array di byte di controllo: per ogni cella piena contiene 7 bit
+   * dell'hash della chiave, altrimenti un marcatore di cella vuota o cancellata. La ricerca esamina
+   * i byte di controllo 16 alla volta (SSE2) e confronta la chiave solo nelle celle il cui byte
+   * corrisponde, quindi tocca in media una sola riga di cache oltre alla cella trovata.
+   *
+   * Per le chiavi stringa (`zkl::string`, `string_view`, `shared_string`, `hashed_string`) usa
+   * `zkl::hash` e un confronto trasparente, così `find`, `contains` ed `erase` accettano anche
+   * `const char*` o `string_view` senza costruire una `zkl::string` temporanea.
+   *
+   * Qualsiasi inserimento che fa crescere la tabella invalida iteratori e riferimenti.
+   *
+   * @tparam K Il tipo delle chiavi.
+   * @tparam V Il tipo dei valori.
+   * @tparam Hash Il funtore di hash delle chiavi.
+   * @tparam KeyEqual Il funtore di confronto delle chiavi.
+   */
+  template <typename K, typename V, typename Hash = typename detail::default_hash<K>::type, typename KeyEqual = typename detail::default_equal<K>::type>
+  class flat_hash_map
+  {
+  public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<const K, V> value_type;
+
+  private:
+    /** Spazio non inizializzato per un elemento; l'elemento esiste solo se la cella è piena. */
+    struct slot
+    {
+      alignas(value_type) unsigned char bytes[sizeof(value_type)];
+    };
+
+  public:
+    /**
+     * @brief Iteratore in avanti sugli elementi della tabella.
+     *
+     * @tparam Const `true` per l'iteratore costante.
+     */
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef typename flat_hash_map::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef typename std::conditional<Const, const value_type*, value_type*>::type pointer;
+      typedef typename std::conditional<Const, const value_type&, value_type&>::type reference;
+
+      /**
+       * @brief Costruttore di default. Crea un iteratore non associato ad alcuna tabella.
+       */
+      basic_iterator() noexcept;
+
+      /**
+       * @brief Conversione da iteratore modificabile a iteratore costante.
+       */
+      template <bool OtherConst, typename = typename std::enable_if<Const && !OtherConst>::type>
+      basic_iterator(const basic_iterator<OtherConst>& other) noexcept;
+
+      reference operator*() const noexcept;
+      pointer operator->() const noexcept;
+      basic_iterator& operator++() noexcept;
+      basic_iterator operator++(int) noexcept;
+
+      template <bool OtherConst>
+      bool operator==(const basic_iterator<OtherConst>& other) const noexcept;
+
+      template <bool OtherConst>
+      bool operator!=(const basic_iterator<OtherConst>& other) const noexcept;
+
+    private:
+      friend class flat_hash_map;
+
+      template <bool>
+      friend class basic_iterator;
+
+      basic_iterator(const int8_t* ctrl, slot* slot) noexcept;
+
+      /**
+       * @brief Avanza fino alla prima cella piena o alla sentinella.
+       */
+      void skip_free() noexcept;
+
+      const int8_t* _ctrl; /**< Byte di controllo della cella corrente. */
+      slot* _slot;         /**< Cella corrente. */
+    };
+
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    /**
+     * @brief Costruttore di default. Crea una tabella vuota senza allocare.
+     */
+    flat_hash_map();
+
+    /**
+     * @brief Costruttore di copia. Copia tutti gli elementi.
+     *
+     * @param other La tabella da copiare.
+     */
+    flat_hash_map(const flat_hash_map& other);
+
+    /**
+     * @brief Costruttore di spostamento. Trasferisce gli array senza toccare gli elementi.
+     *
+     * @param other La tabella da spostare, che rimane vuota.
+     */
+    flat_hash_map(flat_hash_map&& other) noexcept;
+
+    /**
+     * @brief Distruttore. Distrugge tutti gli elementi.
+     */
+    ~flat_hash_map();
 
     /**
-     * @brief Assegna il contenuto di un'altra stringa a questa stringa.
+     * @brief Operatore di assegnazione di copia.
      *
-     * @param str La stringa da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * @param other La tabella da copiare.
+     * @return Riferimento alla tabella assegnata.
      */
-    string& assign(const string& str);
+    flat_hash_map& operator=(const flat_hash_map& other);
 
     /**
-     * @brief Assegna una sottostringa di un'altra stringa a questa stringa.
+     * @brief Operatore di assegnazione di spostamento.
      *
-     * @param str La stringa da cui prendere la sottostringa.
-     * @param subpos La posizione di inizio nella stringa `str`.
-     * @param sublen La lunghezza della sottostringa da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * @param other La tabella da spostare, che rimane vuota.
+     * @return Riferimento alla tabella assegnata.
      */
-    string& assign(const string& str, size_t subpos, size_t sublen);
+    flat_hash_map& operator=(flat_hash_map&& other) noexcept;
+
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
 
     /**
-     * @brief Assegna una stringa C a questa stringa.
+     * @brief Restituisce il numero di elementi.
      *
-     * @param str La stringa C da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * @return Numero di elementi nella tabella.
      */
-    string& assign(const char* str);
+    size_t size() const noexcept;
 
     /**
-     * @brief Assegna i primi `n` caratteri di una stringa C a questa stringa.
+     * @brief Verifica se la tabella è vuota.
      *
-     * @param s La stringa C da assegnare.
-     * @param n Il numero massimo di caratteri da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * @return `true` se la tabella è vuota, `false` altrimenti.
      */
-    string& assign(const char* s, size_t n);
+    bool empty() const noexcept;
 
     /**
-     * @brief Assegna `n` copie di un carattere a questa stringa.
+     * @brief Restituisce il numero di celle allocate.
      *
-     * @param n Il numero di copie del carattere da assegnare.
-     * @param c Il carattere da assegnare.
-     * @return Riferimento alla stringa assegnata.
+     * @return Numero di celle (0 oppure una potenza di 2 di almeno 16).
      */
-    string& assign(size_t n, char c);
+    size_t capacity() const noexcept;
 
     /**
-     * @brief Inserisce una stringa in una posizione specifica.
-     *
-     * @param pos La posizione in cui inserire la stringa.
-     * @param str La stringa da inserire.
-     * @return Riferimento alla stringa modificata.
+     * @brief Rimuove tutti gli elementi mantenendo le celle allocate.
      */
-    string& insert(size_t pos, const string& str);
+    void clear() noexcept;
 
     /**
-     * @brief Inserisce una stringa C in una posizione specifica.
+     * @brief Alloca celle sufficienti per `count` elementi senza ulteriori ridimensionamenti.
      *
-     * @param pos La posizione in cui inserire la stringa C.
-     * @param str La stringa C da inserire.
-     * @return Riferimento alla stringa modificata.
+     * @param count Il numero di elementi previsto.
      */
-    string& insert(size_t pos, const char* str);
+    void reserve(size_t count);
 
     /**
-     * @brief Rimuove una porzione della stringa a partire da una posizione specifica.
+     * @brief Inserisce una coppia chiave-valore se la chiave non è presente.
      *
-     * @param pos La posizione di inizio della porzione da rimuovere.
-     * @param len La lunghezza della porzione da rimuovere. Se omesso, rimuove fino alla fine.
-     * @return Riferimento alla stringa modificata.
+     * @param value La coppia da inserire.
+     * @return L'iteratore all'elemento con quella chiave e `true` se è stato inserito.
      */
-    string& erase(size_t pos, size_t len = npos);
+    std::pair<iterator, bool> insert(const value_type& value);
 
     /**
-     * @brief Sostituisce una porzione della stringa con un'altra stringa.
+     * @brief Inserisce una coppia chiave-valore spostandola, se la chiave non è presente.
      *
-     * @param pos La posizione di inizio della porzione da sostituire.
-     * @param len La lunghezza della porzione da sostituire.
-     * @param str La stringa con cui sostituire.
-     * @return Riferimento alla stringa modificata.
+     * @param value La coppia da inserire.
+     * @return L'iteratore all'elemento con quella chiave e `true` se è stato inserito.
      */
-    string& replace(size_t pos, size_t len, const string& str);
+    std::pair<iterator, bool> insert(value_type&& value);
 
     /**
-     * @brief Sostituisce una porzione della stringa con una stringa C.
+     * @brief Costruisce il valore sul posto se la chiave non è presente; altrimenti non fa nulla.
      *
-     * @param pos La posizione di inizio della porzione da sostituire.
-     * @param len La lunghezza della porzione da sostituire.
-     * @param str La stringa C con cui sostituire.
-     * @return Riferimento alla stringa modificata.
+     * @param key La chiave.
+     * @param args Gli argomenti del costruttore del valore.
+     * @return L'iteratore all'elemento con quella chiave e `true` se è stato inserito.
      */
-    string& replace(size_t pos, size_t len, const char* str);
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args);
 
     /**
-     * @brief Scambia il contenuto di questa stringa con un'altra.
+     * @brief Come `try_emplace(const K&, Args&&...)`, spostando la chiave se viene inserita.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+
+    /**
+     * @brief Restituisce il valore associato a una chiave, inserendo un valore di default se manca.
      *
-     * @param str La stringa con cui scambiare.
+     * @param key La chiave.
+     * @return Riferimento al valore.
      */
-    void swap(string& str);
+    V& operator[](const K& key);
 
     /**
-     * @brief Rimuove l'ultimo carattere della stringa.
+     * @brief Come `operator[](const K&)`, spostando la chiave se viene inserita.
      */
-    void pop_back();
+    V& operator[](K&& key);
 
     /**
-     * @brief Restituisce un puntatore alla stringa C interna.
+     * @brief Restituisce il valore associato a una chiave con controllo.
      *
-     * @return Puntatore costante alla stringa C.
+     * @param key La chiave.
+     * @return Riferimento al valore.
+     *
+     * @throws std::out_of_range se la chiave non è presente.
      */
-    const char* c_str() const noexcept;
+    V& at(const K& key);
 
     /**
-     * @brief Restituisce un puntatore ai dati interni della stringa.
+     * @brief Restituisce il valore associato a una chiave con controllo (versione const).
      *
-     * @return Puntatore costante ai dati della stringa.
+     * @throws std::out_of_range se la chiave non è presente.
      */
-    const char* data() const noexcept;
+    const V& at(const K& key) const;
 
     /**
-     * @brief Copia una porzione della stringa in un buffer.
+     * @brief Cerca una chiave.
      *
-     * @param s Puntatore al buffer di destinazione.
-     * @param len Numero massimo di caratteri da copiare.
-     * @param pos Posizione di inizio nella stringa da cui iniziare la copia.
-     * @return Numero di caratteri effettivamente copiati.
+     * @param key La chiave da cercare.
+     * @return L'iteratore all'elemento, o `end()` se non è presente.
      */
-    size_t copy(char* s, size_t len, size_t pos = 0);
+    iterator find(const K& key);
+    const_iterator find(const K& key) const;
 
     /**
-     * @brief Cerca la prima occorrenza di una stringa all'interno di questa stringa.
+     * @brief Cerca una chiave di un tipo confrontabile con `K` (ricerca eterogenea).
      *
-     * @param str La stringa da cercare.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * Disponibile solo se `Hash` e `KeyEqual` sono trasparenti e producono per `Q` lo stesso
+     * hash e lo stesso confronto di una chiave `K` equivalente.
      */
-    size_t find(const string& str, size_t pos = 0) const noexcept;
+    template <typename Q, typename = typename detail::transparent_key<Hash, KeyEqual, Q>::type>
+    iterator find(const Q& key);
+
+    template <typename Q, typename = typename detail::transparent_key<Hash, KeyEqual, Q>::type>
+    const_iterator find(const Q& key) const;
 
     /**
-     * @brief Cerca la prima occorrenza di un carattere all'interno di questa stringa.
+     * @brief Verifica se una chiave è presente.
      *
-     * @param c Il carattere da cercare.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * @param key La chiave da cercare.
+     * @return `true` se la chiave è presente, `false` altrimenti.
      */
-    size_t find(char c, size_t pos = 0) const noexcept;
+    bool contains(const K& key) const;
+
+    template <typename Q, typename = typename detail::transparent_key<Hash, KeyEqual, Q>::type>
+    bool contains(const Q& key) const;
 
     /**
-     * @brief Cerca la prima occorrenza di una sottostringa all'interno di questa stringa.
+     * @brief Rimuove l'elemento con una chiave, se presente.
      *
-     * @param str La stringa da cercare.
-     * @param pos La posizione di inizio della ricerca.
-     * @param n Numero massimo di caratteri da considerare nella stringa da cercare.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * @param key La chiave da rimuovere.
+     * @return 1 se un elemento è stato rimosso, 0 altrimenti.
      */
-    size_t find(const string& str, size_t pos, size_t n) const noexcept;
+    size_t erase(const K& key);
+
+    template <typename Q, typename = typename detail::transparent_key<Hash, KeyEqual, Q>::type>
+    size_t erase(const Q& key);
 
     /**
-     * @brief Cerca l'ultima occorrenza di una stringa all'interno di questa stringa.
+     * @brief Rimuove l'elemento indicato da un iteratore valido.
      *
-     * @param str La stringa da cercare.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * @param pos L'iteratore all'elemento da rimuovere.
+     * @return L'iteratore all'elemento successivo.
      */
-    size_t rfind(const string& str, size_t pos = npos) const noexcept;
+    iterator erase(const_iterator pos);
 
     /**
-     * @brief Cerca l'ultima occorrenza di un carattere all'interno di questa stringa.
+     * @brief Rimuove l'elemento indicato da un iteratore modificabile.
      *
-     * @param c Il carattere da cercare.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * Serve perché un `iterator` non scelga l'overload trasparente `erase(const Q&)`, così
+     * `it = map.erase(it)` funziona anche con chiavi `zkl::string`.
+     *
+     * @param pos L'iteratore all'elemento da rimuovere.
+     * @return L'iteratore all'elemento successivo.
      */
-    size_t rfind(char c, size_t pos = npos) const noexcept;
+    iterator erase(iterator pos);
 
     /**
-     * @brief Cerca la prima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa stringa.
+     * @brief Scambia il contenuto con un'altra tabella senza copiare gli elementi.
      *
-     * @param str La stringa contenente i caratteri da cercare.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * @param other La tabella con cui scambiare il contenuto.
      */
-    size_t find_first_of(const string& str, size_t pos = 0) const;
+    void swap(flat_hash_map& other) noexcept;
+
+  private:
+    vector<int8_t> _ctrl; /**< Un byte di controllo per cella, più la sentinella finale. */
+    vector<slot> _slots;  /**< Celle contigue, piene solo dove il byte di controllo è non negativo. */
+    size_t _size;         /**< Numero di elementi. */
+    size_t _capacity;     /**< Numero di celle: 0 oppure una potenza di 2 di almeno 16. */
+    size_t _growthLeft;   /**< Celle vuote utilizzabili prima di dover ridimensionare. */
+    Hash _hash;           /**< Funtore di hash. */
+    KeyEqual _equal;      /**< Funtore di confronto. */
+
+    static value_type& value_at(slot& s) noexcept;
+    static const value_type& value_at(const slot& s) noexcept;
 
     /**
-     * @brief Cerca la prima occorrenza di un carattere specifico all'interno di questa stringa.
-     *
-     * @param c Il carattere da cercare.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * @brief Calcola l'hash di una chiave, rimescolato se `Hash` non distribuisce già i bit.
      */
-    size_t find_first_of(char c, size_t pos = 0) const;
+    template <typename Q>
+    size_t hash_key(const Q& key) const;
 
     /**
-     * @brief Cerca l'ultima occorrenza di qualsiasi carattere presente in una stringa all'interno di questa stringa.
+     * @brief Cerca una chiave con l'hash già calcolato.
      *
-     * @param str La stringa contenente i caratteri da cercare.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * @return L'indice della cella, o `_capacity` se non è presente.
      */
-    size_t find_last_of(const string& str, size_t pos = npos) const;
+    template <typename Q>
+    size_t find_index(const Q& key, size_t hash) const;
 
     /**
-     * @brief Cerca l'ultima occorrenza di un carattere specifico all'interno di questa stringa.
-     *
-     * @param c Il carattere da cercare.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * @brief Cerca la prima cella vuota o cancellata lungo la sequenza di sondaggio di `hash`.
      */
-    size_t find_last_of(char c, size_t pos = npos) const;
+    size_t find_free(size_t hash) const noexcept;
 
     /**
-     * @brief Cerca la prima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa stringa.
+     * @brief Prepara una cella libera per un nuovo elemento, ridimensionando se necessario.
      *
-     * @param str La stringa contenente i caratteri da escludere.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * Scrive il byte di controllo ma non costruisce l'elemento.
+     *
+     * @return L'indice della cella.
      */
-    size_t find_first_not_of(const string& str, size_t pos = 0) const;
+    size_t prepare_insert(size_t hash);
 
     /**
-     * @brief Cerca la prima posizione in cui un carattere specifico non si trova all'interno di questa stringa.
+     * @brief Rialloca le celle e reinserisce tutti gli elementi.
      *
-     * @param c Il carattere da escludere.
-     * @param pos La posizione di inizio della ricerca.
-     * @return La posizione della prima occorrenza trovata, o `npos` se non trovata.
+     * @param newCapacity Il nuovo numero di celle (potenza di 2 di almeno 16).
      */
-    size_t find_first_not_of(char c, size_t pos = 0) const;
+    void rehash(size_t newCapacity);
 
     /**
-     * @brief Cerca l'ultima posizione in cui nessuno dei caratteri presenti in una stringa si trova all'interno di questa stringa.
+     * @brief Costruisce l'elemento in una cella preparata da `prepare_insert`.
      *
-     * @param str La stringa contenente i caratteri da escludere.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * Se il costruttore lancia un'eccezione la cella viene marcata come cancellata.
      */
-    size_t find_last_not_of(const string& str, size_t pos = npos) const;
+    template <typename... Args>
+    void construct_at(size_t index, Args&&... args);
 
     /**
-     * @brief Cerca l'ultima posizione in cui un carattere specifico non si trova all'interno di questa stringa.
+     * @brief Distrugge l'elemento di una cella e la marca come libera.
+     */
+    void erase_index(size_t index) noexcept;
+
+    iterator iterator_at(size_t index) noexcept;
+    const_iterator iterator_at(size_t index) const noexcept;
+
+    /**
+     * @brief Numero massimo di elementi per un numero di celle (fattore di carico 7/8).
+     */
+    static size_t max_load(size_t capacity) noexcept;
+  };
+  namespace parallel
+  {
+    /**
+     * @brief Pool di thread con code per thread e furto di lavoro (work stealing).
      *
-     * @param c Il carattere da escludere.
-     * @param pos La posizione massima da cui iniziare la ricerca.
-     * @return La posizione dell'ultima occorrenza trovata, o `npos` se non trovata.
+     * Ogni worker ha una coda propria: inserisce ed estrae i task dalla coda (LIFO, così i task
+     * appena divisi restano nella sua cache) e, quando è vuota, ruba i task più vecchi dalle code
+     * degli altri (FIFO), che sono i pezzi più grandi di lavoro ancora da dividere. I thread
+     * esterni al pool inseriscono in una coda condivisa. I worker senza lavoro dormono su una
+     * variabile condizione.
+     *
+     * I task si avviano e si attendono con `task_group`.
      */
-    size_t find_last_not_of(char c, size_t pos = npos) const;
+    class thread_pool
+    {
+    public:
+      /**
+       * @brief Avvia il pool.
+       *
+       * @param workers Numero di thread worker. Con 0 i task vengono eseguiti solo da chi li attende.
+       */
+      explicit thread_pool(size_t workers);
+
+      thread_pool(const thread_pool&) = delete;
+      thread_pool& operator=(const thread_pool&) = delete;
+
+      /**
+       * @brief Distruttore. Ferma e attende i worker; non devono esserci task in sospeso.
+       */
+      ~thread_pool();
+
+      /**
+       * @brief Restituisce il numero di worker.
+       *
+       * @return Numero di thread del pool, senza contare chi attende.
+       */
+      size_t size() const noexcept;
+
+      /**
+       * @brief Restituisce il pool condiviso usato dagli algoritmi di `zkl::parallel`.
+       *
+       * Viene creato al primo uso con un worker per core meno uno, perché il thread chiamante
+       * lavora mentre attende.
+       *
+       * @return Il pool globale.
+       */
+      static thread_pool& global();
+
+    private:
+      friend class task_group;
+
+      struct queue;
+
+      std::unique_ptr<queue[]> _queues;        /**< Una coda per worker più quella condivisa dei thread esterni (l'ultima). */
+      size_t _workers;                         /**< Numero di worker. */
+      std::unique_ptr<std::thread[]> _threads; /**< I thread worker. */
+      std::atomic<size_t> _queued;             /**< Task in coda in tutte le code. */
+      std::atomic<size_t> _sleeping;           /**< Worker in attesa su `_wake`. */
+      std::atomic<bool> _stop;                 /**< Chiede ai worker di terminare. */
+      std::mutex _sleepMutex;                  /**< Protegge l'attesa su `_wake`. */
+      std::condition_variable _wake;           /**< Sveglia i worker quando arriva un task. */
+
+      /**
+       * @brief Restituisce l'indice della coda del thread corrente: la sua se è un worker di questo pool, altrimenti quella condivisa.
+       */
+      size_t own_queue() const noexcept;
+
+      /**
+       * @brief Inserisce un task nella coda del thread corrente e sveglia un worker se qualcuno dorme.
+       */
+      void submit(std::function<void()> task);
+
+      /**
+       * @brief Esegue un task preso dalla propria coda o rubato a un'altra.
+       *
+       * @return `true` se è stato eseguito un task, `false` se tutte le code erano vuote.
+       */
+      bool run_one();
+
+      /**
+       * @brief Ciclo dei worker: esegue task finché il pool non viene fermato.
+       */
+      void work(size_t index);
+    };
 
     /**
-     * @brief Restituisce una sottostringa a partire da una posizione specifica e di una lunghezza specificata.
+     * @brief Gruppo di task fork-join su un `thread_pool`.
      *
-     * @param pos La posizione di inizio della sottostringa.
-     * @param len La lunghezza della sottostringa. Se omesso, restituisce fino alla fine della stringa.
-     * @return La sottostringa risultante.
+     * `run()` mette in coda un task, `wait()` attende che tutti i task del gruppo (compresi quelli
+     * avviati dai task stessi) siano finiti. Durante l'attesa il thread esegue task dal pool invece
+     * di bloccarsi, quindi i gruppi si possono annidare senza esaurire i worker.
+     * La prima eccezione lanciata da un task viene rilanciata da `wait()`.
      */
-    string substr(size_t pos = 0, size_t len = npos) const;
+    class task_group
+    {
+    public:
+      /**
+       * @brief Crea un gruppo vuoto.
+       *
+       * @param pool Il pool che eseguirà i task.
+       */
+      explicit task_group(thread_pool& pool = thread_pool::global());
+
+      task_group(const task_group&) = delete;
+      task_group& operator=(const task_group&) = delete;
+
+      /**
+       * @brief Distruttore. Attende i task ancora in corso, ignorando le loro eccezioni.
+       */
+      ~task_group();
+
+      /**
+       * @brief Mette in coda un task.
+       *
+       * @param task Funzione senza argomenti; tutto ciò che cattura per riferimento deve restare valido fino a `wait()`.
+       */
+      template <typename F>
+      void run(F&& task);
+
+      /**
+       * @brief Attende tutti i task del gruppo eseguendo lavoro dal pool.
+       *
+       * @throws La prima eccezione lanciata da un task.
+       */
+      void wait();
+
+    private:
+      thread_pool& _pool;            /**< Il pool che esegue i task. */
+      std::atomic<size_t> _pending;  /**< Task avviati e non ancora finiti. */
+      std::atomic<bool> _failed;     /**< Se un task ha già registrato un'eccezione. */
+      std::exception_ptr _exception; /**< La prima eccezione lanciata da un task. */
+
+      /**
+       * @brief Esegue il ciclo di attesa senza rilanciare eccezioni.
+       */
+      void drain() noexcept;
+    };
 
     /**
-     * @brief Confronta questa stringa con un'altra stringa.
+     * @brief Applica `f` a ogni elemento di `[first, last)` in parallelo.
      *
-     * @param str La stringa da confrontare.
-     * @return Un valore negativo se questa stringa è minore, zero se sono uguali, positivo se è maggiore.
+     * L'intervallo viene diviso ricorsivamente a metà fino a pezzi di qualche migliaio di elementi;
+     * i worker liberi rubano le metà ancora da dividere, così il carico si bilancia anche quando il
+     * costo per elemento non è uniforme. L'ordine delle chiamate non è specificato.
+     *
+     * @param first Iteratore ad accesso casuale al primo elemento.
+     * @param last Iteratore oltre l'ultimo elemento.
+     * @param f Funzione chiamata con un riferimento a ogni elemento, da più thread contemporaneamente.
      */
-    int compare(const string& str) const noexcept;
+    template <typename RandomIt, typename F>
+    void for_each(RandomIt first, RandomIt last, F f);
 
     /**
-     * @brief Confronta una porzione di questa stringa con una porzione di un'altra stringa.
+     * @brief Applica `f` a ogni elemento di un contenitore contiguo (ad esempio `zkl::vector`) in parallelo.
+     */
+    template <typename Range, typename F, typename = decltype(std::declval<Range&>().begin())>
+    void for_each(Range& range, F f);
+
+    /**
+     * @brief Scrive in `out[i]` il risultato di `op(first[i])` per ogni elemento, in parallelo.
      *
-     * @param pos La posizione di inizio nella stringa corrente.
-     * @param len La lunghezza della porzione nella stringa corrente.
-     * @param str La stringa da confrontare.
-     * @return Un valore negativo se questa stringa è minore, zero se sono uguali, positivo se è maggiore.
+     * `out` può coincidere con `first` per una trasformazione sul posto.
      *
-     * @throws std::out_of_range se la posizione è maggiore della lunghezza della stringa.
+     * @param first Iteratore ad accesso casuale al primo elemento.
+     * @param last Iteratore oltre l'ultimo elemento.
+     * @param out Iteratore ad accesso casuale alla destinazione, con spazio per `last - first` elementi.
+     * @param op Funzione chiamata da più thread contemporaneamente.
+     * @return Iteratore oltre l'ultimo elemento scritto.
      */
-    int compare(size_t pos, size_t len, const string& str) const noexcept;
+    template <typename RandomIt, typename OutputIt, typename UnaryOp>
+    OutputIt transform(RandomIt first, RandomIt last, OutputIt out, UnaryOp op);
 
     /**
-     * @brief Estrae una linea da un flusso di input e la memorizza nella stringa.
+     * @brief Trasforma un contenitore in un altro della stessa dimensione (o in sé stesso), in parallelo.
      *
-     * @param is Riferimento al flusso di input.
-     * @param str Riferimento alla stringa in cui memorizzare la linea.
-     * @return Riferimento al flusso di input.
+     * @throws std::length_error se `out` ha meno elementi di `range`.
      */
-    friend std::istream& getline(std::istream& is, string& str);
+    template <typename Range, typename OutRange, typename UnaryOp, typename = decltype(std::declval<Range&>().begin())>
+    void transform(Range& range, OutRange& out, UnaryOp op);
 
     /**
-     * @brief Estrae una linea da un flusso di input fino a un delimitatore specificato e la memorizza nella stringa.
+     * @brief Combina gli elementi di `[first, last)` con `op` partendo da `init`, in parallelo.
      *
-     * @param is Riferimento al flusso di input.
-     * @param str Riferimento alla stringa in cui memorizzare la linea.
-     * @param delim Il carattere delimitatore.
-     * @return Riferimento al flusso di input.
+     * Ogni pezzo viene ridotto separatamente e i risultati parziali vengono combinati in ordine,
+     * quindi `op` deve essere associativa ma non necessariamente commutativa.
+     *
+     * @param first Iteratore ad accesso casuale al primo elemento.
+     * @param last Iteratore oltre l'ultimo elemento.
+     * @param init Il valore iniziale, usato una sola volta.
+     * @param op Operazione binaria associativa.
+     * @return Il risultato della riduzione.
      */
-    friend std::istream& getline(std::istream& is, string& str, char delim);
+    template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+    T reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp());
 
-  private:
-    char* _data;  /**< Puntatore ai dati della stringa. */
-    size_t _size; /**< Numero di caratteri nella stringa. */
-  };
+    /**
+     * @brief Combina gli elementi di un contenitore con `op` partendo da `init`, in parallelo.
+     */
+    template <typename Range, typename T, typename BinaryOp = std::plus<>, typename = decltype(std::declval<Range&>().begin())>
+    T reduce(const Range& range, T init, BinaryOp op = BinaryOp());
 
-  /**
-   * @brief Operatore di uguaglianza tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se le stringhe sono uguali, `false` altrimenti.
-   */
-  bool operator==(const string& lhs, const string& rhs) noexcept;
+    /**
+     * @brief Ordina `[first, last)` in parallelo secondo `comp` (ordinamento non stabile).
+     *
+     * L'intervallo viene diviso in un pezzo per thread, ordinato con `std::sort`, e i pezzi vengono
+     * fusi a coppie; ogni fusione è a sua volta divisa tra i thread, quindi anche gli ultimi
+     * passaggi usano tutti i core. Serve un buffer temporaneo di `last - first` elementi. Per i tipi
+     * il cui spostamento può lanciare eccezioni si usa `std::sort` su un solo thread.
+     *
+     * @param first Iteratore ad accesso casuale al primo elemento.
+     * @param last Iteratore oltre l'ultimo elemento.
+     * @param comp Il confronto, chiamato da più thread contemporaneamente.
+     */
+    template <typename RandomIt, typename Compare = std::less<>>
+    void sort(RandomIt first, RandomIt last, Compare comp = Compare());
 
-  /**
-   * @brief Operatore di disuguaglianza tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se le stringhe sono diverse, `false` altrimenti.
-   */
-  bool operator!=(const string& lhs, const string& rhs) noexcept;
+    /**
+     * @brief Ordina un contenitore in parallelo secondo `comp`.
+     */
+    template <typename Range, typename Compare = std::less<>, typename = decltype(std::declval<Range&>().begin())>
+    void sort(Range& range, Compare comp = Compare());
+  } // namespace parallel
+} // namespace zkl
 
+namespace std
+{
   /**
-   * @brief Operatore di minore tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se `lhs` è minore di `rhs`, `false` altrimenti.
+   * @brief Specializzazione di std::hash per `zkl::string`, basata su `zkl::hash`.
    */
-  bool operator<(const string& lhs, const string& rhs) noexcept;
+  template <>
+  struct hash<zkl::string>
+  {
+    size_t operator()(const zkl::string& str) const noexcept
+    {
+      return zkl::hash()(str);
+    }
+  };
 
   /**
-   * @brief Operatore di minore o uguale tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se `lhs` è minore o uguale a `rhs`, `false` altrimenti.
+   * @brief Specializzazione di std::hash per `zkl::string_view`, coerente con quella di `zkl::string`.
    */
-  bool operator<=(const string& lhs, const string& rhs) noexcept;
+  template <>
+  struct hash<zkl::string_view>
+  {
+    size_t operator()(zkl::string_view str) const noexcept
+    {
+      return zkl::hash()(str);
+    }
+  };
 
   /**
-   * @brief Operatore di maggiore tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se `lhs` è maggiore di `rhs`, `false` altrimenti.
+   * @brief Specializzazione di std::hash per `zkl::shared_string`, coerente con quella di `zkl::string`.
    */
-  bool operator>(const string& lhs, const string& rhs) noexcept;
+  template <>
+  struct hash<zkl::shared_string>
+  {
+    size_t operator()(const zkl::shared_string& str) const noexcept
+    {
+      return zkl::hash()(str);
+    }
+  };
 
   /**
-   * @brief Operatore di maggiore o uguale tra due stringhe.
-   *
-   * @param lhs La stringa di sinistra.
-   * @param rhs La stringa di destra.
-   * @return `true` se `lhs` è maggiore o uguale a `rhs`, `false` altrimenti.
+   * @brief Specializzazione di std::hash per `zkl::hashed_string`, che usa l'hash memorizzato.
    */
-  bool operator>=(const string& lhs, const string& rhs) noexcept;
+  template <>
+  struct hash<zkl::hashed_string>
+  {
+    size_t operator()(const zkl::hashed_string& str) const noexcept
+    {
+      return str.hash();
+    }
+  };
 
   /**
-   * @brief Scambia il contenuto di due stringhe.
-   *
-   * @param x La prima stringa.
-   * @param y La seconda stringa.
+   * @brief Specializzazione di std::hash per gli handle di `zkl::intern_table`.
    */
-  void swap(string& x, string& y);
-} // namespace zkl
+  template <>
+  struct hash<zkl::intern_table::handle>
+  {
+    size_t operator()(zkl::intern_table::handle h) const noexcept
+    {
+      return h.hash();
+    }
+  };
+} // namespace std
 
+#include "stats.tpp"
 #include "string.tpp"
+#include "string_view.tpp"
+#include "char_set.tpp"
+#include "searcher.tpp"
+#include "split.tpp"
+#include "numeric.tpp"
+#include "mapped_file.tpp"
+#include "shared_string.tpp"
+#include "hash.tpp"
+#include "intern_table.tpp"
 #include "vector.tpp"
+#include "small_vector.tpp"
+#include "concurrent_vector.tpp"
+#include "ring.tpp"
+#include "memory.tpp"
+#include "flat_hash_map.tpp"
+#include "parallel.tpp"